@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+import std;
+import lysa;
+import lysa.ui;
+
+//
+// Headless benchmark of the UI widget trees.
+//
+// Each scenario builds a parametric widget tree in its own Window and measures
+// every phase (build, first frame, relayout, input, teardown), reporting the
+// time and the number of heap allocations per operation as JSON.
+//
+// Usage: lysa_ui_bench [--font <uri>] [--depth N] [--children N] [--items N]
+//                      [--nodes N] [--chars N] [--output <file>]
+//
+
+namespace {
+    std::atomic<std::uint64_t> allocations{0};
+}
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (const auto ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace lysa::ui::bench {
+
+    struct Options {
+        std::string font{"app://res/fonts/Signwood"};
+        std::string output{};
+        uint32 depth{256};
+        uint32 children{1000};
+        uint32 items{10000};
+        uint32 nodes{50000};
+        uint32 chars{2000};
+    };
+
+    struct Result {
+        std::string scenario;
+        std::string phase;
+        uint64 ops;
+        double nsPerOp;
+        double allocationsPerOp;
+        uint32 sessionsRecorded;
+        uint32 commands;
+        size_t bytes;
+    };
+
+    class Bench {
+    public:
+        explicit Bench(WindowManager& windowManager) : windowManager{windowManager} {}
+
+        // Runs one phase of a scenario, `ops` being the number of operations done by `phase`
+        template<typename F>
+        void measure(const std::string& scenario, const std::string& phase, const uint64 ops, F&& run) {
+            auto& renderer = windowManager.getRenderer();
+            renderer.resetStats();
+            const auto allocationsStart = allocations.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const auto end = std::chrono::steady_clock::now();
+            const auto allocationsCount = allocations.load(std::memory_order_relaxed) - allocationsStart;
+            const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+            const auto count = static_cast<double>(std::max(ops, uint64{1}));
+            results.push_back({
+                .scenario = scenario,
+                .phase = phase,
+                .ops = ops,
+                .nsPerOp = ns / count,
+                .allocationsPerOp = static_cast<double>(allocationsCount) / count,
+                .sessionsRecorded = renderer.getStats().sessionsRecorded,
+                .commands = renderer.getStats().commands,
+                .bytes = renderer.getStats().bytes,
+            });
+        }
+
+        std::shared_ptr<Window> createWindow() const {
+            const auto window = windowManager.create(Rect{0.0f, 0.0f, 1000.0f, 1000.0f});
+            windowManager.drawFrame();
+            return window;
+        }
+
+        void closeWindow(const std::string& scenario, const std::shared_ptr<Window>& window) {
+            measure(scenario, "teardown", 1, [&] {
+                window->close();
+                windowManager.drawFrame();
+            });
+        }
+
+        // N-deep chain of nested panels
+        void nestedPanels(const uint32 depth) {
+            const auto scenario = std::format("nested_panels_{}", depth);
+            const auto window = createWindow();
+            measure(scenario, "build", depth, [&] {
+                auto* parent = &window->getWidget();
+                for (uint32 i = 0; i < depth; i++) {
+                    parent = parent->create<Panel>(Alignment::FILL).get();
+                    parent->setPadding(1);
+                }
+            });
+            measure(scenario, "first_frame", 1, [&] { windowManager.drawFrame(); });
+            measure(scenario, "relayout", 1, [&] {
+                window->setWidth(window->getWidth() - 10.0f);
+                windowManager.drawFrame();
+            });
+            measure(scenario, "idle_frame", 1, [&] { windowManager.drawFrame(); });
+            measure(scenario, "mouse_move", 100, [&] {
+                for (uint32 i = 0; i < 100; i++) {
+                    window->eventMouseMove(0, 500.0f + i, 500.0f);
+                }
+            });
+            closeWindow(scenario, window);
+        }
+
+        // M children of the same container, for every alignment mode
+        void flatChildren(const uint32 count) {
+            for (auto a = static_cast<int>(Alignment::NONE); a <= static_cast<int>(Alignment::CORNERBOTTOMRIGHT); a++) {
+                const auto alignment = static_cast<Alignment>(a);
+                const auto scenario = std::format("flat_children_{}_alignment_{}", count, a);
+                const auto window = createWindow();
+                measure(scenario, "build", count, [&] {
+                    for (uint32 i = 0; i < count; i++) {
+                        window->create<Panel>("width=2;height=2", alignment);
+                    }
+                });
+                measure(scenario, "first_frame", 1, [&] { windowManager.drawFrame(); });
+                measure(scenario, "relayout", 1, [&] {
+                    window->setWidth(window->getWidth() - 10.0f);
+                    windowManager.drawFrame();
+                });
+                closeWindow(scenario, window);
+            }
+        }
+
+        // ListBox of N texts, scrolled with the keyboard
+        void listBox(const uint32 count) {
+            const auto scenario = std::format("list_box_{}", count);
+            const auto window = createWindow();
+            const auto list = window->create<ListBox>(Alignment::FILL);
+            measure(scenario, "build", count, [&] {
+                for (uint32 i = 0; i < count; i++) {
+                    list->addItem(std::make_shared<Text>(std::format("Item {}", i)));
+                }
+            });
+            measure(scenario, "first_frame", 1, [&] { windowManager.drawFrame(); });
+            list->setFocus();
+            list->select(0);
+            const auto steps = std::min(count, uint32{200});
+            measure(scenario, "scroll", steps, [&] {
+                for (uint32 i = 0; i < steps; i++) {
+                    window->eventKeyDown(KEY_DOWN);
+                    windowManager.drawFrame();
+                }
+            });
+            measure(scenario, "get_item", count, [&] {
+                for (uint32 i = 0; i < count; i++) {
+                    list->getItem(static_cast<int32>(i));
+                }
+            });
+            closeWindow(scenario, window);
+        }
+
+        // TreeView of N nodes, 100 children per root node
+        void treeView(const uint32 count) {
+            const auto scenario = std::format("tree_view_{}", count);
+            const auto window = createWindow();
+            const auto tree = window->create<TreeView>(Alignment::FILL);
+            measure(scenario, "build", count, [&] {
+                auto added = uint32{0};
+                while (added < count) {
+                    const auto root = tree->addItem(std::make_shared<Text>(std::format("Node {}", added++)));
+                    for (uint32 i = 0; (i < 99) && (added < count); i++) {
+                        tree->addItem(root, std::make_shared<Text>(std::format("Node {}", added++)));
+                    }
+                }
+            });
+            measure(scenario, "first_frame", 1, [&] { windowManager.drawFrame(); });
+            measure(scenario, "idle_frame", 1, [&] { windowManager.drawFrame(); });
+            measure(scenario, "remove_all", count, [&] {
+                tree->removeAllItems();
+                windowManager.drawFrame();
+            });
+            closeWindow(scenario, window);
+        }
+
+        // Sustained typing in a TextEdit, one frame per character
+        void textEditTyping(const uint32 count) {
+            const auto scenario = std::format("text_edit_typing_{}", count);
+            const auto window = createWindow();
+            const auto edit = window->create<TextEdit>(Alignment::TOP);
+            windowManager.drawFrame();
+            edit->setFocus();
+            measure(scenario, "type", count, [&] {
+                for (uint32 i = 0; i < count; i++) {
+                    window->eventTextInput(std::string(1, static_cast<char>('a' + i % 26)));
+                    windowManager.drawFrame();
+                }
+            });
+            // Multi-kilobyte insertions in the middle of the text
+            const std::string pasted(4096, 'x');
+            measure(scenario, "paste", 10, [&] {
+                for (uint32 i = 0; i < 10; i++) {
+                    edit->setSelStart(static_cast<uint32>(edit->getText().size() / 2));
+                    window->eventTextInput(pasted);
+                    windowManager.drawFrame();
+                }
+            });
+            closeWindow(scenario, window);
+        }
+
+        // Typing in the middle of a TextArea of N lines, one frame per character
+        void textAreaTyping(const uint32 lines, const uint32 count) {
+            const auto scenario = std::format("text_area_typing_{}", lines);
+            const auto window = createWindow();
+            std::string text;
+            for (uint32 i = 0; i < lines; i++) {
+                text += std::format("Line {}\n", i);
+            }
+            const auto area = window->create<TextArea>(Alignment::FILL);
+            measure(scenario, "set_text", lines, [&] {
+                area->setText(text);
+                windowManager.drawFrame();
+            });
+            area->setFocus();
+            area->setCaret(lines / 2, 0);
+            measure(scenario, "type", count, [&] {
+                for (uint32 i = 0; i < count; i++) {
+                    window->eventTextInput(std::string(1, static_cast<char>('a' + i % 26)));
+                    windowManager.drawFrame();
+                }
+            });
+            measure(scenario, "new_line", 100, [&] {
+                for (uint32 i = 0; i < 100; i++) {
+                    window->eventKeyDown(KEY_ENTER);
+                    windowManager.drawFrame();
+                }
+            });
+            closeWindow(scenario, window);
+        }
+
+        std::string toJson() const {
+            std::string json{"{\n  \"results\": [\n"};
+            for (size_t i = 0; i < results.size(); i++) {
+                const auto& r = results[i];
+                json += std::format(
+                    "    {{\"scenario\": \"{}\", \"phase\": \"{}\", \"ops\": {}, \"ns_per_op\": {:.1f}, "
+                    "\"allocations_per_op\": {:.2f}, \"sessions_recorded\": {}, \"commands\": {}, \"bytes\": {}}}{}\n",
+                    r.scenario, r.phase, r.ops, r.nsPerOp,
+                    r.allocationsPerOp, r.sessionsRecorded, r.commands, r.bytes,
+                    i + 1 < results.size() ? "," : "");
+            }
+            json += "  ]\n}\n";
+            return json;
+        }
+
+    private:
+        WindowManager& windowManager;
+        std::vector<Result> results;
+    };
+
+    Options parseOptions(const int argc, char** argv) {
+        Options options;
+        for (auto i = 1; i + 1 < argc; i += 2) {
+            const std::string name{argv[i]};
+            const std::string value{argv[i + 1]};
+            if (name == "--font") {
+                options.font = value;
+            } else if (name == "--output") {
+                options.output = value;
+            } else if (name == "--depth") {
+                options.depth = static_cast<uint32>(std::stoul(value));
+            } else if (name == "--children") {
+                options.children = static_cast<uint32>(std::stoul(value));
+            } else if (name == "--items") {
+                options.items = static_cast<uint32>(std::stoul(value));
+            } else if (name == "--nodes") {
+                options.nodes = static_cast<uint32>(std::stoul(value));
+            } else if (name == "--chars") {
+                options.chars = static_cast<uint32>(std::stoul(value));
+            } else {
+                throw std::invalid_argument("Unknown option " + name);
+            }
+        }
+        return options;
+    }
+
+}
+
+int main(const int argc, char** argv) {
+    using namespace lysa::ui::bench;
+    const auto options = parseOptions(argc, argv);
+
+    lysa::ContextConfiguration contextConfiguration{};
+    lysa::Lysa lysa(contextConfiguration);
+    lysa::ui::WindowManager windowManager(options.font);
+
+    Bench bench{windowManager};
+    bench.nestedPanels(options.depth);
+    bench.flatChildren(options.children);
+    bench.listBox(options.items);
+    bench.treeView(options.nodes);
+    bench.textEditTyping(options.chars);
+    bench.textAreaTyping(options.nodes, options.chars);
+
+    const auto json = bench.toJson();
+    if (options.output.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream(options.output) << json;
+    }
+    return 0;
+}
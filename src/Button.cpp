@@ -21,10 +21,10 @@ namespace lysa::ui {
         if (isPushed()) {
             if (!getRect().contains(x, y)) {
                 setPushed(false);
-                resizeChildren();
+                invalidateLayout();
             } else {
                 Box::eventMouseUp(button, x, y);
-                ctx().events.push(Event{ UIEvent::OnClick, UIEventClick{}, id});
+                UIEvent::push<UIEvent::ON_CLICK>(id, UIEventClick{});
                 return true;
             }
         }
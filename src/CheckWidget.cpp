@@ -19,9 +19,8 @@ namespace lysa::ui {
     void CheckWidget::setState(const State newState) {
         if (state == newState) { return; }
         state = newState;
-        resizeChildren();
-        refresh();
-        ctx().events.push({UIEvent::OnStateChange, UIEventState{.state = newState}, id});
+        invalidateLayout();
+        UIEvent::push<UIEvent::ON_STATE_CHANGE>(id, UIEventState{.state = newState});
     }
 
     bool CheckWidget::eventMouseDown(const MouseButton button, const float x, const float y) {
@@ -16,8 +16,7 @@ namespace lysa::ui {
 
     void Frame::setTitle(const std::string& title) {
         this->title = title;
-        resizeChildren();
-        refresh();
+        invalidateLayout();
     }
 
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.gap_buffer;
+
+namespace lysa::ui {
+
+    GapBuffer::GapBuffer(const std::string_view text) {
+        assign(text);
+    }
+
+    void GapBuffer::assign(const std::string_view text) {
+        buffer.assign(text.begin(), text.end());
+        buffer.resize(text.size() + MIN_GAP);
+        gapStart = text.size();
+        gapEnd = buffer.size();
+    }
+
+    void GapBuffer::insert(const size_t index, const std::string_view text) {
+        moveGap(index);
+        reserveGap(text.size());
+        std::ranges::copy(text, buffer.begin() + gapStart);
+        gapStart += text.size();
+    }
+
+    void GapBuffer::erase(const size_t index, const size_t count) {
+        moveGap(index);
+        gapEnd += std::min(count, buffer.size() - gapEnd);
+    }
+
+    std::string GapBuffer::substr(const size_t index, const size_t count) const {
+        const auto start = std::min(index, size());
+        const auto end = std::min(size(), start + count);
+        std::string result;
+        result.reserve(end - start);
+        if (start < gapStart) {
+            result.append(buffer.data() + start, std::min(end, gapStart) - start);
+        }
+        if (end > gapStart) {
+            const auto gap = gapEnd - gapStart;
+            const auto from = std::max(start, gapStart);
+            result.append(buffer.data() + from + gap, end - from);
+        }
+        return result;
+    }
+
+    void GapBuffer::moveGap(const size_t index) {
+        if (index < gapStart) {
+            // Moves the characters [index, gapStart) after the gap
+            std::copy_backward(buffer.begin() + index, buffer.begin() + gapStart, buffer.begin() + gapEnd);
+            gapEnd -= gapStart - index;
+            gapStart = index;
+        } else if (index > gapStart) {
+            // Moves the characters after the gap, up to index, before the gap
+            const auto count = index - gapStart;
+            std::copy(buffer.begin() + gapEnd, buffer.begin() + gapEnd + count, buffer.begin() + gapStart);
+            gapStart += count;
+            gapEnd += count;
+        }
+    }
+
+    void GapBuffer::reserveGap(const size_t count) {
+        if ((gapEnd - gapStart) >= count) { return; }
+        // Doubles the storage to keep the insertions amortized O(1)
+        const auto after = buffer.size() - gapEnd;
+        const auto newSize = std::max(buffer.size() * 2, size() + count + MIN_GAP);
+        std::vector<char> newBuffer(newSize);
+        std::copy(buffer.begin(), buffer.begin() + gapStart, newBuffer.begin());
+        std::copy(buffer.begin() + gapEnd, buffer.end(), newBuffer.end() - after);
+        buffer = std::move(newBuffer);
+        gapEnd = buffer.size() - after;
+    }
+
+}
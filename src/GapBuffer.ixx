@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.gap_buffer;
+
+import std;
+
+export namespace lysa::ui {
+
+    /**
+     * Text storage with a gap at the last edit position.
+     *
+     * Insertions & deletions at the gap are amortized O(1), moving the gap costs
+     * the distance moved. Used by TextEdit, where the edits follow the caret.
+     */
+    class GapBuffer {
+    public:
+        /**
+         * Creates a buffer holding a text.
+         */
+        GapBuffer(std::string_view text = {});
+
+        /**
+         * Returns the number of characters.
+         */
+        size_t size() const { return buffer.size() - (gapEnd - gapStart); }
+
+        /**
+         * Returns true if there is no characters.
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * Returns the character at a given index.
+         */
+        char operator[](const size_t index) const {
+            return index < gapStart ? buffer[index] : buffer[index + (gapEnd - gapStart)];
+        }
+
+        /**
+         * Replaces all the characters.
+         */
+        void assign(std::string_view text);
+
+        /**
+         * Inserts characters at a given index.
+         */
+        void insert(size_t index, std::string_view text);
+
+        /**
+         * Removes `count` characters starting at `index`.
+         */
+        void erase(size_t index, size_t count = 1);
+
+        /**
+         * Returns `count` characters starting at `index`.
+         */
+        std::string substr(size_t index, size_t count) const;
+
+        /**
+         * Returns all the characters.
+         */
+        std::string str() const { return substr(0, size()); }
+
+    private:
+        //! Minimum size of the gap after a reallocation
+        static constexpr size_t MIN_GAP{64};
+
+        std::vector<char> buffer;
+        size_t gapStart{0};
+        size_t gapEnd{0};
+
+        void moveGap(size_t index);
+
+        void reserveGap(size_t count);
+    };
+
+}
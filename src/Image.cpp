@@ -52,7 +52,7 @@ namespace lysa::ui {
 
     void Image::setColor(const float4 &color) {
         this->color = color;
-        refresh();
+        invalidatePaint();
     }
 
     void Image::setAutoSize(const bool autoSize) {
@@ -78,7 +78,7 @@ namespace lysa::ui {
             if (autoSize) {
                 autoResize();
             } else if (!fixedSize) {
-                refresh();
+                invalidatePaint();
             }
         }
     }
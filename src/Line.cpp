@@ -15,8 +15,7 @@ namespace lysa::ui {
     void Line::setStyle(const LineStyle style) {
         if (this->style != style) {
             this->style = style;
-            resizeChildren();
-            refresh();
+            invalidateLayout();
         }
     }
 
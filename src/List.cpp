@@ -22,36 +22,68 @@ namespace lysa::ui {
         items.push_back(item);
         const auto index = static_cast<int32>(items.size()) - 1;
         computeSizes();
-        ctx().events.push({UIEvent::OnInsertItem, UIEventItem{.index = index, .item = item}, id});
-        refresh();
+        UIEvent::push<UIEvent::ON_INSERT_ITEM>(id, UIEventItem{.index = index, .item = item});
+        invalidatePaint();
         return index;
     }
 
     void List::removeItem(const int32 index) {
         if ((index < 0) || (index >= getCount())) { return; }
-        auto it = items.begin();
-        std::advance(it, index);
-        const auto removed = *it;
-        ctx().events.push({UIEvent::OnRemoveItem, UIEventItem{.index = index, .item = removed}, id});
+        const auto it = items.begin() + index;
+        UIEvent::push<UIEvent::ON_REMOVE_ITEM>(id, UIEventItem{.index = index, .item = *it});
         items.erase(it);
         if (selected == index) {
             selected = NO_SELECTION;
+        } else if (selected > index) {
+            selected -= 1;
         }
         computeSizes();
-        refresh();
+        invalidatePaint();
     }
 
-    void List::removeAllItems() {
-        while (getCount() > 0) {
-            removeItem(0);
+    int32 List::addItems(
+        const std::vector<std::shared_ptr<Widget>>& newItems,
+        const Alignment,
+        const std::string&) {
+        const auto index = getCount();
+        if (newItems.empty()) { return index; }
+        items.insert(items.end(), newItems.begin(), newItems.end());
+        computeSizes();
+        UIEvent::push<UIEvent::ON_INSERT_ITEMS>(id, UIEventItems{.index = index, .count = static_cast<int32>(newItems.size())});
+        invalidatePaint();
+        return index;
+    }
+
+    void List::removeItems(const int32 index, const int32 count) {
+        const auto first = std::max(0, index);
+        const auto last = std::min(getCount(), index + count);
+        if (first >= last) { return; }
+        UIEvent::push<UIEvent::ON_REMOVE_ITEMS>(id, UIEventItems{.index = first, .count = last - first});
+        items.erase(items.begin() + first, items.begin() + last);
+        if ((selected >= first) && (selected < last)) {
+            selected = NO_SELECTION;
+        } else if (selected >= last) {
+            selected -= last - first;
         }
+        computeSizes();
+        invalidatePaint();
+    }
+
+    void List::replaceAll(
+        const std::vector<std::shared_ptr<Widget>>& newItems,
+        const Alignment alignment,
+        const std::string& resource) {
+        removeAllItems();
+        addItems(newItems, alignment, resource);
+    }
+
+    void List::removeAllItems() {
+        removeItems(0, getCount());
     }
 
     std::shared_ptr<Widget> List::getItem(const int32 index) const {
         if ((index < 0) || (index >= getCount())) { return nullptr; }
-        auto it = items.begin();
-        std::advance(it, index); // check here if we need a caching system for long lists
-        return *it;
+        return items[index];
     }
 
     int32 List::getCount() const {
@@ -70,8 +102,8 @@ namespace lysa::ui {
         if (index == selected) { return; }
         prevSelected = selected;
         selected = index;
-        ctx().events.push({UIEvent::OnSelectItem, UIEventItem{.index = index, .item = getItem(index)}, id});
-        refresh();
+        UIEvent::push<UIEvent::ON_SELECT_ITEM>(id, UIEventItem{.index = index, .item = getItem(index)});
+        invalidatePaint();
     }
 
 }
\ No newline at end of file
@@ -45,6 +45,35 @@ export namespace lysa::ui {
          */
         virtual void removeItem(int32 index);
 
+        /**
+         * Adds widgets at the end of the list, with a single size computation
+         * and a single UIEvent::OnInsertItems event.
+         * @param newItems Widgets to add.
+         * @param alignment Placement alignment.
+         * @param resource Resource string.
+         * @return The index (0-based) of the first inserted item.
+         */
+        virtual int32 addItems(
+            const std::vector<std::shared_ptr<Widget>>& newItems,
+            Alignment alignment = Alignment::LEFT,
+            const std::string& resource = "");
+
+        /**
+         * Removes a range of items, with a single size computation
+         * and a single UIEvent::OnRemoveItems event.
+         * @param index Index (0-based) of the first item to remove.
+         * @param count Number of items to remove.
+         */
+        virtual void removeItems(int32 index, int32 count);
+
+        /**
+         * Replaces all the items of the list.
+         */
+        void replaceAll(
+            const std::vector<std::shared_ptr<Widget>>& newItems,
+            Alignment alignment = Alignment::LEFT,
+            const std::string& resource = "");
+
         /**
          * Removes all items.
          */
@@ -78,11 +107,11 @@ export namespace lysa::ui {
         /**
          * Returns the list of item widgets.
          */
-        const std::list<std::shared_ptr<Widget>>& getItems() const { return items; }
+        const std::vector<std::shared_ptr<Widget>>& getItems() const { return items; }
 
     protected:
         int32 prevSelected{NO_SELECTION};
-        std::list<std::shared_ptr<Widget>> items;
+        std::vector<std::shared_ptr<Widget>> items;
 
         // Recompute internal sizes after items change (scroll range, etc.).
         virtual void computeSizes() = 0;
@@ -17,25 +17,118 @@ namespace lysa::ui {
         allowFocus = true;
     }
 
-    int32 ListBox::maxDisplay(const int32 start, const float height) const {
-        int32 md = getCount();
-        float y = 0;
-        for (int32 i = start; i < getCount(); i++) {
-            y += getItem(i)->getHeight() + getPadding() * 2;
-            if (y >= height) {
-                md = i;
-                break;
+    void ListBox::setModel(const std::shared_ptr<Model>& model) {
+        if (this->model == model) { return; }
+        if (box != nullptr) {
+            removeAllItems();
+            for (const auto& row : rows) {
+                box->remove(row);
             }
+            // The virtual rows are placed at -scroll, the box content must not be scrolled too
+            box->setChildrenOffset(0, 0);
+            vscroll->setValue(0);
         }
-        return md;
+        rows.clear();
+        rowsIndex.clear();
+        select(NO_SELECTION);
+        this->model = model;
+        // Updates the scroll range
+        modelChanged();
+    }
+
+    void ListBox::modelChanged() {
+        if (box == nullptr) { return; }
+        std::ranges::fill(rowsIndex, NO_SELECTION);
+        if (getSelectedIndex() >= getRowCount()) {
+            select(NO_SELECTION);
+        }
+        computeSizes();
+        updateRows();
+        setRectSelected(getSelectedIndex());
+    }
+
+    int32 ListBox::getRowCount() const {
+        return model ? model->getRowCount() : getCount();
+    }
+
+    float ListBox::getRowFullHeight(const int32 index) const {
+        return model ? model->getRowHeight() + box->getPadding() * 2 : heights.get(index);
+    }
+
+    float ListBox::getRowTop(const int32 index) const {
+        return model ? index * getRowFullHeight(0) : heights.prefix(index);
+    }
+
+    int32 ListBox::getRowAt(const float position) const {
+        if (model) {
+            const auto rowHeight = getRowFullHeight(0);
+            if ((rowHeight <= 0) || (position < 0)) { return rowHeight <= 0 ? getRowCount() : 0; }
+            return std::min(getRowCount(), static_cast<int32>(position / rowHeight));
+        }
+        return heights.find(position);
+    }
+
+    void ListBox::updateRows() {
+        if ((model == nullptr) || (box == nullptr)) { return; }
+        const auto rowHeight = getRowFullHeight(0);
+        if (rowHeight <= 0) { return; }
+        const auto scroll = vscroll->getValue();
+        const auto first = std::max(0, static_cast<int32>(scroll / rowHeight) - VIRTUAL_ROWS_MARGIN);
+        const auto last = std::min(
+            getRowCount(),
+            static_cast<int32>((scroll + innerHeight) / rowHeight) + 1 + VIRTUAL_ROWS_MARGIN);
+        const auto needed = static_cast<size_t>(std::max(0, last - first));
+        if (rows.size() < needed) {
+            // The slot of each row depends on the pool size : every row must be bound again
+            while (rows.size() < needed) {
+                rows.push_back(box->add(model->createRow(), Alignment::NONE));
+            }
+            rowsIndex.assign(rows.size(), NO_SELECTION);
+        }
+        if (rows.empty()) { return; }
+        const auto left = box->getRect().x + box->getHBorder();
+        const auto top = box->getRect().y + box->getVBorder() + box->getPadding() - scroll;
+        const auto width = box->getWidth() - box->getHBorder() * 2;
+        std::vector displayed(rows.size(), false);
+        for (auto index = first; index < last; index++) {
+            const auto slot = static_cast<size_t>(index) % rows.size();
+            const auto& row = rows[slot];
+            if (rowsIndex[slot] != index) {
+                // Recycles the widget of a row that scrolled out
+                model->bindRow(*row, index);
+                rowsIndex[slot] = index;
+            }
+            row->setRect(left, top + index * rowHeight, width, model->getRowHeight());
+            row->setVisible(true);
+            displayed[slot] = true;
+        }
+        for (size_t slot = 0; slot < rows.size(); slot++) {
+            if (!displayed[slot]) {
+                rows[slot]->setVisible(false);
+                rowsIndex[slot] = NO_SELECTION;
+            }
+        }
+        firstDisplayed = std::max(0, static_cast<int32>(scroll / rowHeight));
+    }
+
+    int32 ListBox::getDisplayedRow(const float position) const {
+        return std::clamp(getRowAt(std::max(0.0f, position)), 0, getRowCount() - 1);
     }
 
     void ListBox::computeSizes() {
         if (box == nullptr) { return; }
         innerHeight = box->getHeight() - box->getVBorder() * 2;
-        totalHeight = 0;
-        for (const auto& item : getItems()) {
-            totalHeight += item->getHeight() + box->getPadding() * 2;
+        if (model) {
+            totalHeight = getRowCount() * getRowFullHeight(0);
+        } else {
+            // The resized items update the prefix sums in onItemRectChange()
+            if (box->getPadding() != heightsPadding) {
+                heightsPadding = box->getPadding();
+                for (int32 i = 0; i < getCount(); i++) {
+                    heights.set(i, items[i]->getHeight() + heightsPadding * 2);
+                }
+            }
+            totalHeight = heights.total();
         }
         vscroll->setMax(totalHeight - innerHeight + vscroll->getStep());
     }
@@ -55,8 +148,11 @@ namespace lysa::ui {
         const std::shared_ptr<Widget>& item,
         const Alignment alignment,
         const std::string& resource) {
+        assert([&]{ return model == nullptr; }, "ListBox items can't be added in virtual mode");
         box->add(item, correctAlignment(alignment), resource);
-        return addItem(item, alignment, resource);
+        heights.push_back(item->getHeight() + heightsPadding * 2);
+        itemsIndex[item.get()] = getCount();
+        return List::addItem(item, alignment, resource);
     }
 
     void ListBox::removeItem(const int32 index) {
@@ -65,7 +161,38 @@ namespace lysa::ui {
             select(index - 1);
         }
         box->remove(getItem(index));
-        removeItem(index);
+        heights.erase(index);
+        itemsIndexDirty = true;
+        List::removeItem(index);
+    }
+
+    int32 ListBox::addItems(
+        const std::vector<std::shared_ptr<Widget>>& newItems,
+        const Alignment alignment,
+        const std::string& resource) {
+        assert([&]{ return model == nullptr; }, "ListBox items can't be added in virtual mode");
+        std::vector<float> newHeights;
+        newHeights.reserve(newItems.size());
+        for (const auto& item : newItems) {
+            box->add(item, correctAlignment(alignment), resource);
+            newHeights.push_back(item->getHeight() + heightsPadding * 2);
+            itemsIndex[item.get()] = getCount() + static_cast<int32>(newHeights.size()) - 1;
+        }
+        heights.insert(heights.size(), newHeights);
+        return List::addItems(newItems, alignment, resource);
+    }
+
+    void ListBox::removeItems(const int32 index, const int32 count) {
+        const auto first = std::max(0, index);
+        const auto last = std::min(getCount(), index + count);
+        if (first >= last) { return; }
+        box->removeChildren(std::span{items}.subspan(first, last - first));
+        heights.erase(first, last - first);
+        itemsIndexDirty = true;
+        List::removeItems(first, last - first);
+        if (getSelectedIndex() == NO_SELECTION) {
+            selection->setVisible(false);
+        }
     }
 
     void ListBox::setResources(
@@ -74,21 +201,19 @@ namespace lysa::ui {
         const std::string& resSel) {
         if (box != nullptr) { return; }
         vscroll = create<VScrollBar>(resScroll, Alignment::RIGHT);
-        box = create<Box>(resBox, Alignment::FILL);
+        box = create<Content>(resBox, Alignment::FILL, this);
         selection = box->create<Selection>(resSel, Alignment::NONE);
 
-        box->setPadding(0);
+        box->setPadding(heightsPadding);
+        box->setClipChildren(true);
         vscroll->setStep(2);
         selection->setVisible(false);
 
-        ctx().events.subscribe(UIEvent::OnMouseDown, box->id, [this](auto evt) {
-            this->onBoxMouseDown(std::any_cast<UIEventMouseButton>(evt.payload));
-        });
-        ctx().events.subscribe(UIEvent::OnResize, box->id, [this](auto evt) {
-            this->onBoxResize(std::any_cast<UIEvent>(evt.payload));
+        UIEvent::subscribe<UIEvent::ON_MOUSE_DOWN>(*box, [this](const UIEventMouseButton& event) {
+            this->onBoxMouseDown(event);
         });
-        ctx().events.subscribe(UIEvent::OnValueChange, vscroll->id, [this](auto evt) {
-            this->onVScrollChange(std::any_cast<UIEventValue>(evt.payload));
+        UIEvent::subscribe<UIEvent::ON_VALUE_CHANGE>(*vscroll, [this](const UIEventValue& event) {
+            this->onVScrollChange(event);
         });
     }
 
@@ -97,9 +222,9 @@ namespace lysa::ui {
         if (idx == getSelectedIndex()) { idx = NO_SELECTION; }
         setFreezed(true);
         setRectSelected(idx);
-        box->refresh();
+        box->invalidatePaint();
         setFreezed(false);
-        eventSelectItem(idx);
+        List::eventSelectItem(idx);
     }
 
     void ListBox::setRectSelected(const int32 index) {
@@ -107,74 +232,75 @@ namespace lysa::ui {
             selection->setVisible(false);
             return;
         }
-        topSelected = box->getRect().y + box->getVBorder();
-        for (int32 i = 0; i < index; i++) {
-            topSelected += getItem(i)->getHeight() + box->getPadding();
-        }
-        const auto item = getItem(index);
+        topSelected = box->getRect().y + box->getVBorder() + getRowTop(index);
         selection->setRect(
             box->getRect().x + box->getHBorder(),
-            topSelected - box->getChildrenOffsetY(),
+            // Without a model the selection is translated with the box content
+            model ? topSelected - vscroll->getValue() : topSelected,
             box->getWidth() - box->getVBorder() * 2,
-            item->getHeight() + box->getPadding() * 2);
+            getRowFullHeight(index));
         selection->setVisible(true);
-        item->refresh();
+        if (const auto item = getItem(index)) { item->invalidatePaint(); }
+    }
+
+    void ListBox::onItemRectChange(const Widget& child, const Rect& previous) {
+        if (model || (child.getHeight() == previous.height)) { return; }
+        if (itemsIndexDirty) {
+            itemsIndex.clear();
+            for (int32 i = 0; i < getCount(); i++) {
+                itemsIndex[items[i].get()] = i;
+            }
+            itemsIndexDirty = false;
+        }
+        // The selection & the items being added are not in the index
+        const auto it = itemsIndex.find(&child);
+        if (it == itemsIndex.end()) { return; }
+        heights.set(it->second, child.getHeight() + heightsPadding * 2);
+        invalidateLayout();
     }
 
-    void ListBox::onBoxResize(const UIEvent&) {
+    void ListBox::eventLayout() {
         computeSizes();
+        updateRows();
         setRectSelected(getSelectedIndex());
     }
 
     void ListBox::onBoxMouseDown(const UIEventMouseButton& event) {
-        if (getCount() == 0) { return; }
-        float y = (event.y - (box->getRect().y + box->getVBorder())) + box->getChildrenOffsetY();
-        int32 hit = NO_SELECTION;
-        int32 i = 0;
-        for (const auto& w : getItems()) {
-            y -= box->getPadding();
-            if (y < w->getHeight()) {
-                hit = i;
-                break;
-            }
-            y -= w->getHeight();
-            i++;
-        }
+        if (getRowCount() == 0) { return; }
+        float y = (event.y - (box->getRect().y + box->getVBorder())) + vscroll->getValue();
+        const auto hit = y >= 0 ? getRowAt(y) : NO_SELECTION;
         box->setPushed(false);
-        if (hit >= 0) { select(hit); }
+        if ((hit >= 0) && (hit < getRowCount())) { select(hit); }
     }
 
     bool ListBox::eventKeyDown(const Key key) {
-        if (getCount() == 0) { return Widget::eventKeyDown(key); }
+        const auto count = getRowCount();
+        if (count == 0) { return Widget::eventKeyDown(key); }
         const auto idx = getSelectedIndex();
-        const auto max = maxDisplay(idx < 0 ? 0 : idx, box->getHeight());
-        const auto value = static_cast<int32>(vscroll->getValue());
+        const auto scroll = vscroll->getValue();
+        // First & last fully displayed rows
+        const auto first = getDisplayedRow(scroll);
+        const auto last = std::max(first, getDisplayedRow(scroll + innerHeight) - 1);
         if ((key == KEY_UP) && (idx > 0)) {
             select(idx - 1);
         }
-        else if ((key == KEY_DOWN) && (idx < getCount() - 1)) {
+        else if ((key == KEY_DOWN) && (idx < count - 1)) {
             select(idx + 1);
         }
         else if ((key == KEY_PAGE_UP) && (idx > 0)) {
-            if ((idx - value) > 0) {
-                select(value);
-            }
-            else if (value < max) {
-                select(0);
+            if (idx > first) {
+                select(first);
             }
             else {
-                select(value - max);
+                select(getDisplayedRow(getRowTop(idx) - innerHeight));
             }
         }
-        else if ((key == KEY_PAGE_DOWN) && (idx < getCount() - 1)) {
-            if ((idx - value) < max) {
-                select(value + max - 1);
-            }
-            else if (idx > (getCount() - max)) {
-                select(getCount() - 1);
+        else if ((key == KEY_PAGE_DOWN) && (idx < count - 1)) {
+            if (idx < last) {
+                select(last);
             }
             else {
-                select(idx + max);
+                select(std::max(idx + 1, getDisplayedRow(getRowTop(idx) + innerHeight)));
             }
         }
         else {
@@ -184,24 +310,19 @@ namespace lysa::ui {
     }
 
     void ListBox::onVScrollChange(const UIEventValue& event) {
-        float y = 0;
-        int32 i = 0;
-        for (const auto& w : getItems()) {
-            y += w->getHeight() + box->getPadding() * 2;
-            if (y > event.value) {
-                firstDisplayed = i;
-                break;
+        if (model) {
+            // Only the displayed rows are moved, no layout of the box content
+            updateRows();
+            if (getSelectedIndex() >= 0) {
+                selection->setPos(selection->getRect().x, topSelected - event.value);
             }
-            i++;
+            invalidatePaint();
+            return;
         }
-        // Scroll the box content: resizeChildren() (triggered by setChildrenOffset)
-        // re-lays out every item from the offset client origin.
+        firstDisplayed = getRowAt(event.value);
+        // Scroll the box content, items & selection included, by translating their sessions :
+        // the items keep their layout
         box->setChildrenOffset(0, event.value);
-        if (getSelectedIndex() >= 0) {
-            selection->setPos(selection->getRect().x, topSelected - event.value);
-            if (const auto sel = getSelectedItem()) { sel->refresh(); }
-        }
-        refresh();
     }
 
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ import lysa.ui.alignment;
 import lysa.ui.box;
 import lysa.ui.event;
 import lysa.ui.list;
+import lysa.ui.prefix_sums;
 import lysa.ui.scroll_bar;
 import lysa.ui.selection;
 import lysa.ui.widget;
@@ -21,14 +22,72 @@ export namespace lysa::ui {
 
     /**
      * A scrollable list of widgets with a selection highlight.
+     *
+     * In virtual mode (see setModel()) the rows are not added as items : the ListBox asks
+     * a Model for the rows count & content and only creates widgets for the displayed rows,
+     * recycling them while scrolling.
      */
     class ListBox : public List {
     public:
+        /**
+         * Data source of a virtual ListBox.
+         */
+        class Model {
+        public:
+            virtual ~Model() = default;
+
+            /**
+             * Returns the number of rows.
+             */
+            virtual int32 getRowCount() const = 0;
+
+            /**
+             * Returns the height of the rows, in UI units.
+             */
+            virtual float getRowHeight() const = 0;
+
+            /**
+             * Creates a widget able to display any row. Row widgets are recycled while scrolling.
+             */
+            virtual std::shared_ptr<Widget> createRow() = 0;
+
+            /**
+             * Updates a row widget with the content of a row.
+             * @param row Row widget created by createRow().
+             * @param index Index (0-based) of the row to display.
+             */
+            virtual void bindRow(Widget& row, int32 index) = 0;
+        };
+
+        //! Number of rows created above & below the displayed ones in virtual mode.
+        static constexpr int32 VIRTUAL_ROWS_MARGIN{2};
+
         /**
          * Creates a default ListBox widget.
          */
         ListBox();
 
+        /**
+         * Switches the list to virtual mode, removing all the items.
+         * Pass nullptr to go back to a list of items.
+         */
+        void setModel(const std::shared_ptr<Model>& model);
+
+        /**
+         * Returns the data source of the virtual mode, or nullptr.
+         */
+        const auto& getModel() const { return model; }
+
+        /**
+         * Must be called when the rows count or content of the model changed.
+         */
+        void modelChanged();
+
+        /**
+         * Returns the number of rows : the items count, or the model rows count in virtual mode.
+         */
+        int32 getRowCount() const;
+
         int32 addItem(
             const std::shared_ptr<Widget>& item,
             Alignment alignment = Alignment::LEFT,
@@ -40,6 +99,13 @@ export namespace lysa::ui {
          */
         void removeItem(int32 index) override;
 
+        int32 addItems(
+            const std::vector<std::shared_ptr<Widget>>& newItems,
+            Alignment alignment = Alignment::LEFT,
+            const std::string& resource = "") override;
+
+        void removeItems(int32 index, int32 count) override;
+
         /**
          * Sets the UI resources for the list box.
          * @param resBox Resource for the inner background box.
@@ -57,6 +123,20 @@ export namespace lysa::ui {
         auto getSelectionWidget() const { return selection; }
 
     private:
+        // Inner box forwarding the size changes of the items to the ListBox
+        class Content : public Box {
+        public:
+            Content(ListBox* listBox): listBox{listBox} {}
+
+        protected:
+            void eventChildRectChange(const Widget& child, const Rect& previous) override {
+                listBox->onItemRectChange(child, previous);
+            }
+
+        private:
+            ListBox* listBox;
+        };
+
         float topSelected{0};
         float innerHeight{0};
         float totalHeight{0};
@@ -64,9 +144,17 @@ export namespace lysa::ui {
         std::shared_ptr<Selection> selection;
         std::shared_ptr<Box> box;
         std::shared_ptr<VScrollBar> vscroll;
-
-        //! Largest first-fully-visible index given a start index & a height.
-        int32 maxDisplay(int32 start, float height) const;
+        std::shared_ptr<Model> model;
+        // Recycled row widgets of the virtual mode, row `index` is displayed by rows[index % rows.size()]
+        std::vector<std::shared_ptr<Widget>> rows;
+        std::vector<int32> rowsIndex;
+        // Rows heights (with padding) of the items, for O(log n) position <-> row lookups
+        PrefixSums heights;
+        // Box padding included in `heights`
+        float heightsPadding{0};
+        // Index of each item, rebuilt on the first resize after a removal
+        std::unordered_map<const Widget*, int32> itemsIndex;
+        bool itemsIndexDirty{false};
 
         Alignment correctAlignment(Alignment alignment) const;
 
@@ -74,7 +162,21 @@ export namespace lysa::ui {
         void eventSelectItem(int32 index) override;
         void setRectSelected(int32 index);
 
-        void onBoxResize(const UIEvent& event);
+        // Height of a row, including the padding
+        float getRowFullHeight(int32 index) const;
+        // Top of a row relative to the content origin
+        float getRowTop(int32 index) const;
+        // Row at a position relative to the content origin, getRowCount() after the last row
+        int32 getRowAt(float position) const;
+        // Row at a position clamped to the existing rows, the list must not be empty
+        int32 getDisplayedRow(float position) const;
+        // Creates, binds & places the displayed rows of the virtual mode
+        void updateRows();
+
+        // Updates the height of a resized item
+        void onItemRectChange(const Widget& child, const Rect& previous);
+
+        void eventLayout() override;
         void onBoxMouseDown(const UIEventMouseButton& event);
         bool eventKeyDown(Key key) override;
         void onVScrollChange(const UIEventValue& event);
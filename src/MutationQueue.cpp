@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.mutation_queue;
+
+namespace lysa::ui {
+
+    MutationQueue::~MutationQueue() {
+        destroy(head.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    void MutationQueue::destroy(Node* node) {
+        while (node != nullptr) {
+            auto* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void MutationQueue::post(Mutation mutation) {
+        auto* node = new Node{std::move(mutation), head.load(std::memory_order_relaxed)};
+        // Publishes the node, the release makes the mutation visible to the consumer
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    MutationQueue::Node* MutationQueue::take() {
+        // The consumer takes the whole list : no node is ever popped while a producer reads it
+        auto* node = head.exchange(nullptr, std::memory_order_acquire);
+        Node* first = nullptr;
+        while (node != nullptr) {
+            auto* next = node->next;
+            node->next = first;
+            first = node;
+            node = next;
+        }
+        return first;
+    }
+
+    size_t MutationQueue::drain() {
+        size_t count = 0;
+        auto* node = take();
+        try {
+            while (node != nullptr) {
+                node->mutation();
+                count += 1;
+                const auto* done = node;
+                node = node->next;
+                delete done;
+            }
+        } catch (...) {
+            // The mutations after the failed one are dropped
+            destroy(node);
+            throw;
+        }
+        return count;
+    }
+
+}
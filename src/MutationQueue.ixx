@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.mutation_queue;
+
+import std;
+
+export namespace lysa::ui {
+
+    /**
+     * Multi-producer, single-consumer queue of UI mutations.
+     *
+     * Any thread can post() a mutation without taking a lock : the producers push on an atomic
+     * linked list. The UI thread takes all the pending mutations at once with drain() and runs
+     * them in the order they were posted by each producer.
+     */
+    class MutationQueue {
+    public:
+        //! A mutation, run on the UI thread
+        using Mutation = std::function<void()>;
+
+        MutationQueue() = default;
+
+        /**
+         * Destroys the pending mutations without running them.
+         */
+        ~MutationQueue();
+
+        MutationQueue(const MutationQueue&) = delete;
+        MutationQueue& operator=(const MutationQueue&) = delete;
+
+        /**
+         * Posts a mutation. Can be called from any thread.
+         */
+        void post(Mutation mutation);
+
+        /**
+         * Runs all the pending mutations. Must only be called from the UI thread.
+         * The mutations posted while draining are run by the next call.
+         * @return The number of mutations run.
+         */
+        size_t drain();
+
+        /**
+         * Returns true if no mutation is pending. The result can be outdated as soon as returned.
+         */
+        bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+
+    private:
+        struct Node {
+            Mutation mutation;
+            Node* next;
+        };
+
+        // Last posted mutation, the list is in reverse order
+        std::atomic<Node*> head{nullptr};
+
+        // Takes all the pending mutations, in posting order
+        Node* take();
+
+        // Deletes a list of nodes
+        static void destroy(Node* node);
+    };
+
+}
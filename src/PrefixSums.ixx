@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.prefix_sums;
+
+import std;
+import lysa.types;
+
+export namespace lysa::ui {
+
+    /**
+     * Sizes of a sequence of rows with O(log n) prefix sums, backed by a Fenwick tree.
+     *
+     * Used by the lists to convert a row index to a position and a position to a row index
+     * without walking the rows. When all the rows have the same size the lookups are O(1).
+     */
+    template<typename T>
+    class BasicPrefixSums {
+    public:
+        /**
+         * Returns the number of rows.
+         */
+        int32 size() const { return static_cast<int32>(values.size()); }
+
+        /**
+         * Returns true if there is no rows.
+         */
+        bool empty() const { return values.empty(); }
+
+        /**
+         * Returns the size of a row.
+         */
+        T get(const int32 index) const { return values[index]; }
+
+        /**
+         * Removes all the rows.
+         */
+        void clear();
+
+        /**
+         * Adds a row at the end, in O(log n).
+         */
+        void push_back(T value);
+
+        /**
+         * Changes the size of a row, in O(log n).
+         */
+        void set(int32 index, T value);
+
+        /**
+         * Inserts rows at a given index, in O(n), or in O(log n) per row at the end.
+         */
+        void insert(int32 index, std::span<const T> inserted);
+
+        /**
+         * Removes `count` rows starting at `index`, in O(n), or in O(1) at the end.
+         */
+        void erase(int32 index, int32 count = 1);
+
+        /**
+         * Returns the sum of the sizes of the rows [0, count).
+         */
+        T prefix(int32 count) const;
+
+        /**
+         * Returns the sum of the sizes of all the rows.
+         */
+        T total() const { return prefix(size()); }
+
+        /**
+         * Returns the index of the row containing a position, or size() if
+         * the position is after the last row.
+         */
+        int32 find(T position) const;
+
+    private:
+        std::vector<T> values;
+        // Fenwick tree, 1-based
+        std::vector<T> tree{T{}};
+        // All the rows have the same size, the tree is not used for lookups
+        bool uniform{true};
+
+        void rebuild();
+    };
+
+    /**
+     * Prefix sums of the sizes of rows in UI units.
+     */
+    using PrefixSums = BasicPrefixSums<float>;
+
+    template<typename T>
+    void BasicPrefixSums<T>::clear() {
+        values.clear();
+        tree.assign(1, T{});
+        uniform = true;
+    }
+
+    template<typename T>
+    void BasicPrefixSums<T>::push_back(const T value) {
+        uniform = uniform && (values.empty() || (values.front() == value));
+        values.push_back(value);
+        // The new node covers the rows (n - lowbit(n), n]
+        const auto n = size();
+        tree.push_back(value + prefix(n - 1) - prefix(n - (n & -n)));
+    }
+
+    template<typename T>
+    void BasicPrefixSums<T>::set(const int32 index, const T value) {
+        const auto diff = value - values[index];
+        if (diff == T{}) { return; }
+        values[index] = value;
+        uniform = uniform && (size() == 1);
+        for (auto i = index + 1; i <= size(); i += i & -i) {
+            tree[i] += diff;
+        }
+    }
+
+    template<typename T>
+    void BasicPrefixSums<T>::insert(const int32 index, const std::span<const T> inserted) {
+        if (index == size()) {
+            // Appending does not change the existing nodes
+            for (const auto value : inserted) {
+                push_back(value);
+            }
+            return;
+        }
+        values.insert(values.begin() + index, inserted.begin(), inserted.end());
+        rebuild();
+    }
+
+    template<typename T>
+    void BasicPrefixSums<T>::erase(const int32 index, const int32 count) {
+        if ((index + count) == size()) {
+            // The remaining nodes only cover the remaining rows
+            values.resize(index);
+            tree.resize(index + 1);
+            return;
+        }
+        values.erase(values.begin() + index, values.begin() + index + count);
+        rebuild();
+    }
+
+    template<typename T>
+    T BasicPrefixSums<T>::prefix(const int32 count) const {
+        if (uniform) {
+            return values.empty() ? T{} : static_cast<T>(count * values.front());
+        }
+        auto sum = T{};
+        for (auto i = count; i > 0; i -= i & -i) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    template<typename T>
+    int32 BasicPrefixSums<T>::find(const T position) const {
+        if (position < T{}) { return 0; }
+        if (uniform) {
+            if (values.empty() || (values.front() <= T{})) { return size(); }
+            return std::min(size(), static_cast<int32>(position / values.front()));
+        }
+        // Binary lifting : largest pos with prefix(pos) <= position
+        auto pos = 0;
+        auto remaining = position;
+        auto step = 1;
+        while ((step << 1) <= size()) { step <<= 1; }
+        for (; step > 0; step >>= 1) {
+            if (((pos + step) <= size()) && (tree[pos + step] <= remaining)) {
+                pos += step;
+                remaining -= tree[pos];
+            }
+        }
+        return pos;
+    }
+
+    template<typename T>
+    void BasicPrefixSums<T>::rebuild() {
+        uniform = std::ranges::all_of(values, [&](const T v) { return v == values.front(); });
+        tree.assign(values.size() + 1, T{});
+        for (auto i = 1; i <= size(); i++) {
+            tree[i] += values[i - 1];
+            if (const auto parent = i + (i & -i); parent <= size()) {
+                tree[parent] += tree[i];
+            }
+        }
+    }
+
+}
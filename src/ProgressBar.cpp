@@ -28,12 +28,12 @@ namespace lysa::ui {
 
     void ProgressBar::setDisplay(const Display display) {
         this->display = display;
-        refresh();
+        invalidatePaint();
     }
 
     void ProgressBar::setOrientation(const Orientation orientation) {
         this->orientation = orientation;
-        refresh();
+        invalidatePaint();
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.recording_renderer;
+
+import lysa.exception;
+
+namespace lysa::ui {
+
+    RecordingRenderer::RecordingRenderer(const float aspectRatio):
+        aspectRatio{aspectRatio} {
+    }
+
+    unique_id RecordingRenderer::beginDraw(const unique_id session) {
+        assert([&]{ return current == nullptr; }, "RecordingRenderer: beginDraw() called before endDraw()");
+        const auto id = session == INVALID_ID ? nextSession++ : session;
+        current = &sessions[id];
+        current->commands.clear();
+        current->translate = translate;
+        current->recordCount += 1;
+        stats.sessionsRecorded += 1;
+        return id;
+    }
+
+    void RecordingRenderer::endDraw() {
+        current = nullptr;
+    }
+
+    void RecordingRenderer::clearSession(const unique_id session) {
+        sessions.erase(session);
+    }
+
+    void RecordingRenderer::setVisible(const unique_id session, const bool visible) {
+        if (const auto it = sessions.find(session); it != sessions.end()) {
+            it->second.visible = visible;
+        }
+    }
+
+    void RecordingRenderer::setPenColor(const float4& color) {
+        record({.type = Command::PEN_COLOR, .color = color});
+    }
+
+    void RecordingRenderer::drawFilledRect(const Rect& rect, const unique_id texture) {
+        record({.type = Command::FILLED_RECT, .rect = rect, .texture = texture});
+    }
+
+    void RecordingRenderer::drawFilledRect(
+        const float x,
+        const float y,
+        const float width,
+        const float height,
+        const unique_id texture) {
+        Rect rect;
+        rect.x = x;
+        rect.y = y;
+        rect.width = width;
+        rect.height = height;
+        drawFilledRect(rect, texture);
+    }
+
+    void RecordingRenderer::drawLine(const float2& start, const float2& end) {
+        record({.type = Command::LINE, .start = start, .end = end});
+    }
+
+    void RecordingRenderer::drawText(
+        const std::string& text,
+        const Font&,
+        const float fontScale,
+        const float x,
+        const float y) {
+        record({.type = Command::TEXT, .start = {x, y}, .scale = fontScale, .text = text});
+    }
+
+    const RecordingRenderer::Session* RecordingRenderer::getSession(const unique_id session) const {
+        const auto it = sessions.find(session);
+        return it == sessions.end() ? nullptr : &it->second;
+    }
+
+    void RecordingRenderer::record(Command&& command) {
+        assert([&]{ return current != nullptr; }, "RecordingRenderer: drawing outside of beginDraw()/endDraw()");
+        stats.commands += 1;
+        stats.bytes += sizeof(Command) + command.text.size();
+        current->commands.push_back(std::move(command));
+    }
+
+}
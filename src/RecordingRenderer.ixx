@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.recording_renderer;
+
+import lysa.context;
+import lysa.math;
+import lysa.rect;
+import lysa.resources.font;
+import lysa.types;
+
+export namespace lysa::ui {
+
+    /**
+     * CPU-only stand-in for the Vector2DRenderer used by the UI.
+     *
+     * Exposes the same drawing surface (sessions, pen color, rectangles, lines and texts)
+     * but records the commands of each session into memory instead of rendering them,
+     * so the UI can run without a GPU and its drawing can be inspected and measured.
+     *
+     * Used as the UI renderer when building with `LYSA_UI_HEADLESS`.
+     */
+    class RecordingRenderer {
+    public:
+        /**
+         * A recorded drawing command.
+         */
+        struct Command {
+            enum Type : uint8 {
+                PEN_COLOR,   //! Pen color change, uses color
+                FILLED_RECT, //! Filled rectangle, uses rect & texture
+                LINE,        //! Line, uses start & end
+                TEXT,        //! Text, uses text, scale & start
+            };
+            Type type;
+            float4 color{0.0f};
+            Rect rect{};
+            float2 start{0.0f};
+            float2 end{0.0f};
+            unique_id texture{INVALID_ID};
+            float scale{1.0f};
+            std::string text{};
+        };
+
+        /**
+         * Recorded commands of a draw session.
+         */
+        struct Session {
+            std::vector<Command> commands;
+            //! Translation set with setTranslate() when the session was recorded
+            float2 translate{0.0f};
+            bool visible{true};
+            //! Number of times the session has been recorded
+            uint32 recordCount{0};
+        };
+
+        /**
+         * Counters accumulated since the last call to resetStats().
+         */
+        struct Stats {
+            //! Number of beginDraw() calls
+            uint32 sessionsRecorded{0};
+            //! Number of recorded commands
+            uint32 commands{0};
+            //! Memory used by the recorded commands
+            size_t bytes{0};
+        };
+
+        /**
+         * Creates a recording renderer.
+         * @param aspectRatio The aspect ratio of the simulated render target.
+         */
+        RecordingRenderer(float aspectRatio = 1.0f);
+
+        /**
+         * Starts the recording of a draw session, clearing its previous commands.
+         * @param session Session to record again, or INVALID_ID to create a new one.
+         * @return The id of the recorded session.
+         */
+        unique_id beginDraw(unique_id session = INVALID_ID);
+
+        /**
+         * Ends the recording of the current draw session.
+         */
+        void endDraw();
+
+        /**
+         * Destroys a draw session.
+         */
+        void clearSession(unique_id session);
+
+        /**
+         * Shows or hides a draw session.
+         */
+        void setVisible(unique_id session, bool visible);
+
+        /**
+         * Sets the color used by the next drawing commands.
+         */
+        void setPenColor(const float4& color);
+
+        /**
+         * Records a filled rectangle.
+         */
+        void drawFilledRect(const Rect& rect, unique_id texture = INVALID_ID);
+
+        /**
+         * Records a filled rectangle.
+         */
+        void drawFilledRect(float x, float y, float width, float height, unique_id texture = INVALID_ID);
+
+        /**
+         * Records a line.
+         */
+        void drawLine(const float2& start, const float2& end);
+
+        /**
+         * Records a text.
+         */
+        void drawText(const std::string& text, const Font& font, float fontScale, float x, float y);
+
+        /**
+         * Sets the translation applied by the next recorded sessions.
+         */
+        void setTranslate(const float2& translate) { this->translate = translate; }
+
+        /**
+         * Sets the transparency applied by the next recorded sessions.
+         */
+        void setTransparency(const float alpha) { transparency = alpha; }
+
+        /**
+         * Returns the aspect ratio of the simulated render target.
+         */
+        float getAspectRatio() const { return aspectRatio; }
+
+        /**
+         * Returns the last translation set with setTranslate().
+         */
+        const float2& getTranslate() const { return translate; }
+
+        /**
+         * Returns the last transparency set with setTransparency().
+         */
+        float getTransparency() const { return transparency; }
+
+        /**
+         * Returns a recorded session, or nullptr if it does not exist.
+         */
+        const Session* getSession(unique_id session) const;
+
+        /**
+         * Returns all the recorded sessions.
+         */
+        const std::unordered_map<unique_id, Session>& getSessions() const { return sessions; }
+
+        /**
+         * Returns the counters accumulated since the last call to resetStats().
+         */
+        const Stats& getStats() const { return stats; }
+
+        /**
+         * Resets the counters, usually at the start of a frame.
+         */
+        void resetStats() { stats = {}; }
+
+    private:
+        float aspectRatio;
+        float2 translate{0.0f};
+        float transparency{0.0f};
+        unique_id nextSession{1};
+        Session* current{nullptr};
+        std::unordered_map<unique_id, Session> sessions;
+        Stats stats;
+
+        void record(Command&& command);
+    };
+
+}
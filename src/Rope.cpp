@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.rope;
+
+namespace lysa::ui {
+
+    Rope::Rope(const std::string_view text) {
+        assign(text);
+    }
+
+    void Rope::assign(const std::string_view text) {
+        chunks.clear();
+        split(text, chunks);
+        std::vector<int32> chunkSizes;
+        std::vector<int32> chunkLineBreaks;
+        for (const auto& chunk : chunks) {
+            chunkSizes.push_back(static_cast<int32>(chunk.size()));
+            chunkLineBreaks.push_back(static_cast<int32>(std::ranges::count(chunk, '\n')));
+        }
+        sizes.clear();
+        sizes.insert(0, chunkSizes);
+        lineBreaks.clear();
+        lineBreaks.insert(0, chunkLineBreaks);
+    }
+
+    std::pair<size_t, size_t> Rope::locate(const size_t position) const {
+        if (chunks.empty()) { return {0, 0}; }
+        if (position >= size()) {
+            // End of the text : end of the last chunk
+            return {chunks.size() - 1, chunks.back().size()};
+        }
+        const auto chunk = static_cast<size_t>(sizes.find(static_cast<int32>(position)));
+        return {chunk, position - static_cast<size_t>(sizes.prefix(static_cast<int32>(chunk)))};
+    }
+
+    size_t Rope::getLineStart(const size_t line) const {
+        if (line == 0) { return 0; }
+        if (line >= getLineCount()) { return size(); }
+        // Chunk containing the line break ending the previous line
+        const auto chunk = static_cast<size_t>(lineBreaks.find(static_cast<int32>(line - 1)));
+        auto remaining = static_cast<int32>(line) - lineBreaks.prefix(static_cast<int32>(chunk));
+        const auto& text = chunks[chunk];
+        for (size_t i = 0; i < text.size(); i++) {
+            if ((text[i] == '\n') && (--remaining == 0)) {
+                return static_cast<size_t>(sizes.prefix(static_cast<int32>(chunk))) + i + 1;
+            }
+        }
+        return size();
+    }
+
+    size_t Rope::getLineLength(const size_t line) const {
+        const auto start = getLineStart(line);
+        if ((line + 1) >= getLineCount()) { return size() - start; }
+        return getLineStart(line + 1) - 1 - start;
+    }
+
+    size_t Rope::getLineAt(const size_t position) const {
+        if (chunks.empty()) { return 0; }
+        const auto [chunk, offset] = locate(position);
+        const auto& text = chunks[chunk];
+        return static_cast<size_t>(lineBreaks.prefix(static_cast<int32>(chunk))) +
+               static_cast<size_t>(std::count(text.begin(), text.begin() + offset, '\n'));
+    }
+
+    char Rope::operator[](const size_t position) const {
+        const auto [chunk, offset] = locate(position);
+        return chunks[chunk][offset];
+    }
+
+    void Rope::insert(const size_t position, const std::string_view text) {
+        if (text.empty()) { return; }
+        if (chunks.empty()) {
+            assign(text);
+            return;
+        }
+        const auto [chunk, offset] = locate(position);
+        chunks[chunk].insert(offset, text);
+        update(chunk);
+    }
+
+    void Rope::erase(const size_t position, const size_t count) {
+        auto remaining = std::min(count, size() - std::min(position, size()));
+        while (remaining > 0) {
+            const auto [chunk, offset] = locate(position);
+            const auto erased = std::min(remaining, chunks[chunk].size() - offset);
+            chunks[chunk].erase(offset, erased);
+            remaining -= erased;
+            if (chunks[chunk].empty()) {
+                chunks.erase(chunks.begin() + chunk);
+                sizes.erase(static_cast<int32>(chunk));
+                lineBreaks.erase(static_cast<int32>(chunk));
+            } else {
+                update(chunk);
+            }
+        }
+    }
+
+    std::string Rope::substr(const size_t position, const size_t count) const {
+        std::string result;
+        if (chunks.empty()) { return result; }
+        auto remaining = std::min(count, size() - std::min(position, size()));
+        result.reserve(remaining);
+        auto [chunk, offset] = locate(position);
+        while ((remaining > 0) && (chunk < chunks.size())) {
+            const auto copied = std::min(remaining, chunks[chunk].size() - offset);
+            result.append(chunks[chunk], offset, copied);
+            remaining -= copied;
+            chunk++;
+            offset = 0;
+        }
+        return result;
+    }
+
+    void Rope::update(const size_t chunk) {
+        if (chunks[chunk].size() <= (CHUNK_SIZE * 2)) {
+            sizes.set(static_cast<int32>(chunk), static_cast<int32>(chunks[chunk].size()));
+            lineBreaks.set(static_cast<int32>(chunk), static_cast<int32>(std::ranges::count(chunks[chunk], '\n')));
+            return;
+        }
+        // Large insertion : replaces the chunk by chunks of CHUNK_SIZE
+        std::vector<std::string> parts;
+        split(chunks[chunk], parts);
+        std::vector<int32> partSizes;
+        std::vector<int32> partLineBreaks;
+        for (const auto& part : parts) {
+            partSizes.push_back(static_cast<int32>(part.size()));
+            partLineBreaks.push_back(static_cast<int32>(std::ranges::count(part, '\n')));
+        }
+        chunks.erase(chunks.begin() + chunk);
+        chunks.insert(chunks.begin() + chunk, std::make_move_iterator(parts.begin()), std::make_move_iterator(parts.end()));
+        sizes.erase(static_cast<int32>(chunk));
+        sizes.insert(static_cast<int32>(chunk), partSizes);
+        lineBreaks.erase(static_cast<int32>(chunk));
+        lineBreaks.insert(static_cast<int32>(chunk), partLineBreaks);
+    }
+
+    void Rope::split(const std::string_view text, std::vector<std::string>& result) {
+        for (size_t start = 0; start < text.size(); start += CHUNK_SIZE) {
+            result.emplace_back(text.substr(start, CHUNK_SIZE));
+        }
+    }
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.rope;
+
+import std;
+import lysa.types;
+import lysa.ui.prefix_sums;
+
+export namespace lysa::ui {
+
+    /**
+     * Multi-line text storage split into chunks of bounded size.
+     *
+     * The sizes and the number of line breaks of the chunks are kept in prefix sums :
+     * locating a position, the start of a line or the line of a position costs
+     * O(log n) plus a scan of one chunk, and an edit only rewrites the edited chunk.
+     * Used by TextArea.
+     */
+    class Rope {
+    public:
+        //! Size of the chunks created when splitting a text
+        static constexpr size_t CHUNK_SIZE{1024};
+
+        /**
+         * Creates a rope holding a text.
+         */
+        Rope(std::string_view text = {});
+
+        /**
+         * Returns the number of characters.
+         */
+        size_t size() const { return static_cast<size_t>(sizes.total()); }
+
+        /**
+         * Returns true if there is no characters.
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * Returns the number of lines, a text always having at least one line.
+         */
+        size_t getLineCount() const { return static_cast<size_t>(lineBreaks.total()) + 1; }
+
+        /**
+         * Returns the position of the first character of a line.
+         */
+        size_t getLineStart(size_t line) const;
+
+        /**
+         * Returns the number of characters of a line, without the line break.
+         */
+        size_t getLineLength(size_t line) const;
+
+        /**
+         * Returns the line containing a position.
+         */
+        size_t getLineAt(size_t position) const;
+
+        /**
+         * Returns the characters of a line, without the line break.
+         */
+        std::string getLine(size_t line) const { return substr(getLineStart(line), getLineLength(line)); }
+
+        /**
+         * Returns the character at a given position.
+         */
+        char operator[](size_t position) const;
+
+        /**
+         * Replaces all the characters.
+         */
+        void assign(std::string_view text);
+
+        /**
+         * Inserts characters at a given position.
+         */
+        void insert(size_t position, std::string_view text);
+
+        /**
+         * Removes `count` characters starting at `position`.
+         */
+        void erase(size_t position, size_t count = 1);
+
+        /**
+         * Returns `count` characters starting at `position`.
+         */
+        std::string substr(size_t position, size_t count) const;
+
+        /**
+         * Returns all the characters.
+         */
+        std::string str() const { return substr(0, size()); }
+
+    private:
+        std::vector<std::string> chunks;
+        // Number of characters of each chunk
+        BasicPrefixSums<int32> sizes;
+        // Number of line breaks of each chunk
+        BasicPrefixSums<int32> lineBreaks;
+
+        // Returns the chunk containing a position and the position in the chunk
+        std::pair<size_t, size_t> locate(size_t position) const;
+
+        // Updates the prefix sums of an edited chunk, splitting it if too large
+        void update(size_t chunk);
+
+        // Splits a text into chunks, appended to `result`
+        static void split(std::string_view text, std::vector<std::string>& result);
+    };
+
+}
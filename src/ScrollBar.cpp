@@ -28,11 +28,11 @@ namespace lysa::ui {
             mouseMoveOnFocus = true;
             liftArea = create<Box>(area, Alignment::FILL);
             liftCage = create<Box>(cage, Alignment::NONE);
-            ctx().events.subscribe(UIEvent::OnMouseDown, liftArea->id, [this](auto evt) {
-                this->onLiftAreaDown(std::any_cast<UIEventMouseButton>(evt.payload));
+            UIEvent::subscribe<UIEvent::ON_MOUSE_DOWN>(*liftArea, [this](const UIEventMouseButton& event) {
+                this->onLiftAreaDown(event);
             });
-            ctx().events.subscribe(UIEvent::OnMouseDown, liftCage->id, [this](auto evt) {
-                this->onLiftCageDown(std::any_cast<UIEventMouseButton>(evt.payload));
+            UIEvent::subscribe<UIEvent::ON_MOUSE_DOWN>(*liftCage, [this](const UIEventMouseButton& event) {
+                this->onLiftCageDown(event);
             });
             liftCage->_setRedrawOnMouseEvent(true);
             liftCage->_setMoveChildrenOnPush(true);
@@ -162,8 +162,8 @@ namespace lysa::ui {
         else {
             liftCage->setPos(rect.x + liftPos, rect.y);
         }
-        liftArea->refresh();
-        liftCage->refresh();
+        liftArea->invalidatePaint();
+        liftCage->invalidatePaint();
     }
 
 }
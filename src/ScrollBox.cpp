@@ -31,18 +31,48 @@ namespace lysa::ui {
         const Alignment alignment,
         const std::string& resource) {
         const auto w = innerBox->add(child, alignment, resource);
-        computeSizes();
+        extendBounds(*w);
         return w;
     }
 
     void ScrollBox::removeContent(const std::shared_ptr<Widget>& child) {
+        if (child->getParent() == innerBox.get()) {
+            shrinkBounds(child->getRect());
+        }
         innerBox->remove(child);
-        computeSizes();
     }
 
     void ScrollBox::removeAllContent() {
         innerBox->removeAll();
-        computeSizes();
+        contentWidth = 0.0f;
+        contentHeight = 0.0f;
+        invalidateLayout();
+    }
+
+    void ScrollBox::addContents(
+        const std::vector<std::shared_ptr<Widget>>& children,
+        const Alignment alignment,
+        const std::string& resource) {
+        for (const auto& child : children) {
+            extendBounds(*innerBox->add(child, alignment, resource));
+        }
+    }
+
+    void ScrollBox::removeContents(const std::vector<std::shared_ptr<Widget>>& children) {
+        for (const auto& child : children) {
+            if (child->getParent() == innerBox.get()) {
+                shrinkBounds(child->getRect());
+            }
+        }
+        innerBox->removeChildren(children);
+    }
+
+    void ScrollBox::replaceAllContent(
+        const std::vector<std::shared_ptr<Widget>>& children,
+        const Alignment alignment,
+        const std::string& resource) {
+        removeAllContent();
+        addContents(children, alignment, resource);
     }
 
     void ScrollBox::setResources(
@@ -52,18 +82,19 @@ namespace lysa::ui {
         if (innerBox != nullptr) { return; }
         vscroll = create<VScrollBar>(resVScroll, Alignment::RIGHTTOP);
         hscroll = create<HScrollBar>(resHScroll, Alignment::BOTTOMLEFT);
-        innerBox = create<Box>(resBox, Alignment::FILL);
+        innerBox = create<Content>(resBox, Alignment::FILL, this);
         setPadding(0);
 
         innerBox->setDrawBackground(false);
+        innerBox->setClipChildren(true);
         vscroll->setStep(4);
         hscroll->setStep(4);
 
-        ctx().events.subscribe(UIEvent::OnValueChange, vscroll->id, [this](auto evt) {
-            this->onVScrollChange(std::any_cast<UIEventValue>(evt.payload));
+        UIEvent::subscribe<UIEvent::ON_VALUE_CHANGE>(*vscroll, [this](const UIEventValue& event) {
+            this->onVScrollChange(event);
         });
-        ctx().events.subscribe(UIEvent::OnValueChange, hscroll->id, [this](auto evt) {
-            this->onHScrollChange(std::any_cast<UIEventValue>(evt.payload));
+        UIEvent::subscribe<UIEvent::ON_VALUE_CHANGE>(*hscroll, [this](const UIEventValue& event) {
+            this->onHScrollChange(event);
         });
     }
 
@@ -74,29 +105,75 @@ namespace lysa::ui {
             if (vscroll) { vscroll->setMax(0); }
             return;
         }
-        // Bounds of the children relative to the inner box content origin.
+        if (boundsDirty) {
+            boundsDirty = false;
+            contentWidth = 0.0f;
+            contentHeight = 0.0f;
+            for (const auto& child : innerBox->getChildren()) {
+                extendBounds(*child);
+            }
+        }
+        hscroll->setMax(std::max(0.0f, contentWidth - innerBox->getWidth()));
+        vscroll->setMax(std::max(0.0f, contentHeight - innerBox->getHeight()));
+    }
+
+    void ScrollBox::getExtent(const Rect& rect, float& right, float& bottom) const {
         const auto& boxRect = innerBox->getRect();
-        const auto leftOffset = innerBox->getPadding() - boxRect.x - innerBox->getHBorder();
-        const auto topOffset  = innerBox->getPadding() - boxRect.y - innerBox->getVBorder();
-        float maxWidth = 0;
-        float maxHeight = 0;
-        for (const auto& child : innerBox->getChildren()) {
-            const auto& r = child->getRect();
-            maxWidth  = std::max(maxWidth, r.x + leftOffset + r.width);
-            maxHeight = std::max(maxHeight, r.y + topOffset + r.height);
+        right  = rect.x + innerBox->getPadding() - boxRect.x - innerBox->getHBorder() + rect.width;
+        bottom = rect.y + innerBox->getPadding() - boxRect.y - innerBox->getVBorder() + rect.height;
+    }
+
+    void ScrollBox::extendBounds(const Widget& child) {
+        if (boundsDirty) { return; }
+        float right, bottom;
+        getExtent(child.getRect(), right, bottom);
+        contentWidth  = std::max(contentWidth, right);
+        contentHeight = std::max(contentHeight, bottom);
+    }
+
+    void ScrollBox::shrinkBounds(const Rect& rect) {
+        if (boundsDirty) { return; }
+        float right, bottom;
+        getExtent(rect, right, bottom);
+        if ((right >= contentWidth) || (bottom >= contentHeight)) {
+            boundsDirty = true;
+        }
+    }
+
+    void ScrollBox::onContentRectChange(const Widget& child, const Rect& previous) {
+        if (boundsDirty) { return; }
+        // A child growing extends the bounds, a child defining the extent & shrinking needs a recompute
+        float right, bottom, previousRight, previousBottom;
+        getExtent(child.getRect(), right, bottom);
+        getExtent(previous, previousRight, previousBottom);
+        if (((previousRight >= contentWidth) && (right < previousRight)) ||
+            ((previousBottom >= contentHeight) && (bottom < previousBottom))) {
+            boundsDirty = true;
+            return;
+        }
+        contentWidth  = std::max(contentWidth, right);
+        contentHeight = std::max(contentHeight, bottom);
+    }
+
+    void ScrollBox::eventChildRectChange(const Widget& child, const Rect& previous) {
+        Box::eventChildRectChange(child, previous);
+        if (&child == innerBox.get()) {
+            // The content origin moved
+            boundsDirty = true;
         }
-        hscroll->setMax(std::max(0.0f, maxWidth - innerBox->getWidth()));
-        vscroll->setMax(std::max(0.0f, maxHeight - innerBox->getHeight()));
+    }
+
+    void ScrollBox::eventLayout() {
+        computeSizes();
     }
 
     void ScrollBox::onVScrollChange(const UIEventValue& event) {
+        // Translates the content when drawing, the content keeps its layout & bounds
         innerBox->setChildrenOffset(hscroll->getValue(), event.value);
-        refresh();
     }
 
     void ScrollBox::onHScrollChange(const UIEventValue& event) {
         innerBox->setChildrenOffset(event.value, vscroll->getValue());
-        refresh();
     }
 
 }
\ No newline at end of file
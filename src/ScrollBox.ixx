@@ -7,6 +7,7 @@
 export module lysa.ui.scroll_box;
 
 import lysa.context;
+import lysa.rect;
 import lysa.types;
 import lysa.ui.alignment;
 import lysa.ui.box;
@@ -49,6 +50,30 @@ export namespace lysa::ui {
          */
         void removeAllContent();
 
+        /**
+         * Adds children widgets to the scrollable inner box, with a single scroll ranges computation.
+         * @param children Children widgets to add.
+         * @param alignment Placement alignment inside the inner box.
+         * @param resource Resource string.
+         */
+        void addContents(
+            const std::vector<std::shared_ptr<Widget>>& children,
+            Alignment alignment = Alignment::TOPLEFT,
+            const std::string& resource = "");
+
+        /**
+         * Removes children widgets from the inner box, with a single scroll ranges computation.
+         */
+        void removeContents(const std::vector<std::shared_ptr<Widget>>& children);
+
+        /**
+         * Replaces all the children of the inner box.
+         */
+        void replaceAllContent(
+            const std::vector<std::shared_ptr<Widget>>& children,
+            Alignment alignment = Alignment::TOPLEFT,
+            const std::string& resource = "");
+
         /**
          * Sets the UI resources for the scroll box.
          * @param resBox Resource for the inner box.
@@ -68,14 +93,48 @@ export namespace lysa::ui {
     protected:
         ScrollBox(Type type);
 
+        void eventChildRectChange(const Widget& child, const Rect& previous) override;
+
     private:
+        // Inner box forwarding the geometry changes of its children to the ScrollBox
+        class Content : public Box {
+        public:
+            Content(ScrollBox* scrollBox): scrollBox{scrollBox} {}
+
+        protected:
+            void eventChildRectChange(const Widget& child, const Rect& previous) override {
+                scrollBox->onContentRectChange(child, previous);
+            }
+
+        private:
+            ScrollBox* scrollBox;
+        };
+
+        // Extent of the children relative to the inner box content origin
+        float contentWidth{0.0f};
+        float contentHeight{0.0f};
+        // The extent must be recomputed from all the children
+        bool boundsDirty{true};
         std::shared_ptr<Box> innerBox;
         std::shared_ptr<VScrollBar> vscroll;
         std::shared_ptr<HScrollBar> hscroll;
 
-        //! Recompute scroll ranges from the inner box children bounds.
+        //! Update the scroll ranges from the children bounds, recomputed only when needed.
         void computeSizes();
 
+        // Right & bottom of a child rect relative to the inner box content origin
+        void getExtent(const Rect& rect, float& right, float& bottom) const;
+
+        // Grows the content extent to include a child
+        void extendBounds(const Widget& child);
+
+        // Marks the extent for recompute if a removed child defined it
+        void shrinkBounds(const Rect& rect);
+
+        void onContentRectChange(const Widget& child, const Rect& previous);
+
+        void eventLayout() override;
+
         void onVScrollChange(const UIEventValue& event);
         void onHScrollChange(const UIEventValue& event);
     };
@@ -10,7 +10,7 @@ import std;
 import lysa.context;
 import lysa.rect;
 import lysa.resources.font;
-import lysa.renderers.vector_2d;
+import lysa.ui.renderer;
 import lysa.ui.uiresource;
 import lysa.ui.widget;
 
@@ -63,7 +63,7 @@ namespace lysa::ui {
          * @param render The 2D renderer.
          * @param when True = before drawing children, False = after.
          */
-        virtual void draw(const Widget &widget, UIResource &resources, Vector2DRenderer &render, bool when) const = 0;
+        virtual void draw(const Widget &widget, UIResource &resources, UIRenderer &render, bool when) const = 0;
 
         /**
          * Adjusts a widget size to style specific constraints.
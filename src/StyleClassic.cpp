@@ -29,7 +29,7 @@ namespace lysa::ui {
         }*/
     }
 
-    void StyleClassic::draw(const Widget &widget, UIResource &resources, Vector2DRenderer &renderer, const bool before) const {
+    void StyleClassic::draw(const Widget &widget, UIResource &resources, UIRenderer &renderer, const bool before) const {
         auto &res = static_cast<StyleClassicResource &>(resources);
         if (!widget.isVisible()) {
             return;
@@ -72,6 +72,9 @@ namespace lysa::ui {
             case Widget::SELECTION:
                 drawSelection((const Selection &)widget, res, renderer);
             break;
+            case Widget::TREEVIEWROW:
+                drawTreeViewRow((const TreeView::Row &)widget, res, renderer);
+                break;
                 /*case Widget::GRIDCELL:
                     DrawGridCell((GGridCell&)W, D, res);
                     break;
@@ -100,6 +103,9 @@ namespace lysa::ui {
                 case Widget::TEXTEDIT:
                     drawTextEdit((TextEdit&)widget, renderer);
                     break;
+                case Widget::TEXTAREA:
+                    drawTextArea((TextArea&)widget, renderer);
+                    break;
             case Widget::PROGRESSBAR:
                 drawProgressBar((const ProgressBar &)widget, res, renderer);
                 break;
@@ -114,7 +120,10 @@ namespace lysa::ui {
     }
 
     void StyleClassic::addResource(Widget &widget, const std::string &resources) {
-        const auto& res = std::make_shared<StyleClassicResource>(resources);
+        const auto& arena = widget._getArena();
+        const auto& res = arena != nullptr ?
+            std::allocate_shared<StyleClassicResource>(ArenaAllocator<StyleClassicResource>{arena}, resources) :
+            std::make_shared<StyleClassicResource>(resources);
         widget.setResource(res);
         widget.setSize(res->width, res->height);
         switch (widget.getType()) {
@@ -127,6 +136,9 @@ namespace lysa::ui {
         case Widget::TEXTEDIT:
             static_cast<TextEdit&>(widget).setResources(resources);
             break;
+        case Widget::TEXTAREA:
+            static_cast<TextArea&>(widget).setResources("style=LOWERED", "width=18;height=18;style=RAISED");
+            break;
         case Widget::LISTBOX:
             static_cast<ListBox &>(widget).setResources(
                 "style=LOWERED",
@@ -172,9 +184,7 @@ namespace lysa::ui {
         case Widget::FRAME: {
                 widget.setHBorder(4);
                 float w, h;
-                widget.getFont()->getSize(
-                    static_cast<Frame &>(widget).getTitle(),
-                    widget.getFontScale(), w, h); // TODO text scale in Frame
+                widget.measureText(static_cast<Frame &>(widget).getTitle(), w, h); // TODO text scale in Frame
                 widget.setVBorder(h - 2);
             }
             break;
@@ -210,7 +220,7 @@ namespace lysa::ui {
         return float4{R, G, B, A};
     }
 
-    void StyleClassic::drawPanel(const Panel &widget, StyleClassicResource &resources, Vector2DRenderer &renderer) const {
+    void StyleClassic::drawPanel(const Panel &widget, StyleClassicResource &resources, UIRenderer &renderer) const {
         if (widget.isDrawBackground()) {
             auto c = resources.customColor ? resources.color : fgDown;
             c.a = widget.getTransparency();
@@ -223,7 +233,7 @@ namespace lysa::ui {
     void StyleClassic::drawBox(
         const Widget &widget,
         const StyleClassicResource &resources,
-        Vector2DRenderer &renderer,
+        UIRenderer &renderer,
         const bool pushable) const {
         if ((widget.getWidth() < 4) || (widget.getHeight() < 4)) {
             return;
@@ -276,7 +286,7 @@ namespace lysa::ui {
         }
     }
 
-    void StyleClassic::drawLine(const Line &widget, const StyleClassicResource &resource, Vector2DRenderer &renderer) const {
+    void StyleClassic::drawLine(const Line &widget, const StyleClassicResource &resource, UIRenderer &renderer) const {
         float4 color;
         if (resource.customColor) {
             color = resource.color;
@@ -293,12 +303,12 @@ namespace lysa::ui {
         }
     }
 
-    void StyleClassic::drawButton(const Button &widget, StyleClassicResource &resource, Vector2DRenderer &renderer) const {
+    void StyleClassic::drawButton(const Button &widget, StyleClassicResource &resource, UIRenderer &renderer) const {
         resource.style = widget.isPushed() ? StyleClassicResource::LOWERED : StyleClassicResource::RAISED;
         drawBox(widget, resource, renderer, true);
     }
 
-    void StyleClassic::drawToggleButton(ToggleButton &widget, StyleClassicResource &resources, Vector2DRenderer &renderer) const {
+    void StyleClassic::drawToggleButton(ToggleButton &widget, StyleClassicResource &resources, UIRenderer &renderer) const {
         if (widget.getState() == CheckWidget::CHECK) {
             resources.style = StyleClassicResource::LOWERED;
             widget.setPushed(true);
@@ -309,7 +319,7 @@ namespace lysa::ui {
         drawBox(widget, resources, renderer, true);
     }
 
-    void StyleClassic::drawText(const Text &widget, const StyleClassicResource &resources, Vector2DRenderer &renderer) const {
+    void StyleClassic::drawText(const Text &widget, const StyleClassicResource &resources, UIRenderer &renderer) const {
         renderer.setPenColor(
             widget.isEnabled() ? (resources.customColor ? resources.color :
             float4{widget.getTextColor().r, widget.getTextColor().g, widget.getTextColor().b, widget.getTransparency()}) :
@@ -322,7 +332,7 @@ namespace lysa::ui {
             widget.getRect().y);
     }
 
-    void StyleClassic::drawFrame(Frame &widget, StyleClassicResource &resources, Vector2DRenderer &renderer) const {
+    void StyleClassic::drawFrame(Frame &widget, StyleClassicResource &resources, UIRenderer &renderer) const {
         if ((widget.getWidth() < 4) || (widget.getHeight() < 4)) {
             return;
         }
@@ -352,7 +362,7 @@ namespace lysa::ui {
             break;
         }
         float fh, fw;
-        widget.getFont()->getSize(widget.getTitle(), widget.getFontScale(), fw, fh);
+        widget.measureText(widget.getTitle(), fw, fh);
         // fw /= renderer.getAspectRatio();
         renderer.setPenColor(c2);
         if ((!widget.getTitle().empty()) && (widget.getWidth() >= (fw + LEFTOFFSET)) && (widget.getHeight() >= fh)) {
@@ -379,15 +389,10 @@ namespace lysa::ui {
         renderer.drawLine({l, b}, {l + w, b}); // bottom
     }
 
-    void StyleClassic::drawTextEdit(const TextEdit& widget, Vector2DRenderer& renderer) const {
+    void StyleClassic::drawTextEdit(const TextEdit& widget, UIRenderer& renderer) const {
         if (widget.isFocused() && (!widget.isReadOnly())) {
-            float w, h;
-            const auto txt = widget.getDisplayedText().substr(
-                0,
-                widget.getSelStart() - widget.getFirstDisplayedChar());
-            widget.getFont()->getSize(txt, widget.getFontScale(), w, h);
-            h = widget.getTextBox()->getHeight();
-            auto l = widget.getTextBox()->getRect().x + w;
+            const auto h = widget.getTextBox()->getHeight();
+            auto l = widget.getTextBox()->getRect().x + widget.getCaretOffset();
             auto t =  widget.getTextBox()->getRect().y - 2 ;
             // renderer.setPenColor(shadowDark);
             renderer.setPenColor({1.0, 0.0, 0.0, 1.0});
@@ -397,10 +402,27 @@ namespace lysa::ui {
         }
     }
 
+    void StyleClassic::drawTextArea(const TextArea& widget, UIRenderer& renderer) const {
+        if (widget.isFocused() && (!widget.isReadOnly())) {
+            // Only the caret of a displayed line is drawn
+            const auto row = widget.getLineWidget(widget.getCaretLine());
+            if ((row == nullptr) || !row->isVisible()) { return; }
+            const auto& r = row->getRect();
+            const auto h = widget.getLineHeight();
+            if ((r.y < widget.getRect().y) || ((r.y + h) > (widget.getRect().y + widget.getRect().height))) { return; }
+            auto l = r.x + widget.getCaretOffset();
+            auto t = r.y;
+            renderer.setPenColor({1.0, 0.0, 0.0, 1.0});
+            renderer.drawLine({l - 2, t}, {l - 2 + 5, t});
+            renderer.drawLine({l - 2, t + h}, {l - 2 + 5, t + h});
+            renderer.drawLine({l, t}, {l, t + h});
+        }
+    }
+
     void StyleClassic::drawSelection(
         const Selection &widget,
         const StyleClassicResource &resources,
-        Vector2DRenderer &renderer) const {
+        UIRenderer &renderer) const {
         if (!widget.isDrawBackground()) { return; }
         auto c = resources.customColor ? resources.color : focus;
         c.a = widget.getTransparency();
@@ -408,10 +430,29 @@ namespace lysa::ui {
         renderer.drawFilledRect(widget.getRect());
     }
 
+    void StyleClassic::drawTreeViewRow(
+        const TreeView::Row &widget,
+        const StyleClassicResource &resources,
+        UIRenderer &renderer) const {
+        if (widget.getHandle() == TreeView::Row::NONE) { return; }
+        const auto& r = widget.getRect();
+        // "+" or "-" centered in a square handle area, after the indentation
+        const auto half = widget.getHandleSize() / 4;
+        const auto cx = r.x + widget.getIndent() + widget.getHandleSize() / 2;
+        const auto cy = r.y + r.height / 2;
+        auto c = resources.customColor ? resources.color : shadowDark;
+        c.a = widget.getTransparency();
+        renderer.setPenColor(c);
+        renderer.drawLine({cx - half, cy}, {cx + half, cy});
+        if (widget.getHandle() == TreeView::Row::COLLAPSED) {
+            renderer.drawLine({cx, cy - half}, {cx, cy + half});
+        }
+    }
+
     void StyleClassic::drawProgressBar(
         const ProgressBar &widget,
         const StyleClassicResource &resources,
-        Vector2DRenderer &renderer) const {
+        UIRenderer &renderer) const {
         const auto range = widget.getMax() - widget.getMin();
         if (range <= 0.0f) { return; }
         const auto ratio = (widget.getValue() - widget.getMin()) / range;
@@ -440,7 +481,7 @@ namespace lysa::ui {
                 text = std::to_string(static_cast<int32>(widget.getValue()));
             }
             float tw, th;
-            widget.getFont()->getSize(text, widget.getFontScale(), tw, th);
+            widget.measureText(text, tw, th);
             renderer.setPenColor(float4{0.0f, 0.0f, 0.0f, widget.getTransparency()});
             renderer.drawText(
                 text,
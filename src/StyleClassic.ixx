@@ -8,7 +8,7 @@ export module lysa.ui.style_classic;
 
 import lysa.math;
 import lysa.rect;
-import lysa.renderers.vector_2d;
+import lysa.ui.renderer;
 import lysa.ui.button;
 import lysa.ui.check_widget;
 import lysa.ui.frame;
@@ -22,6 +22,7 @@ import lysa.ui.selection;
 import lysa.ui.style;
 import lysa.ui.style_classic_resource;
 import lysa.ui.text;
+import lysa.ui.text_area;
 import lysa.ui.text_edit;
 import lysa.ui.toggle_button;
 import lysa.ui.tree_view;
@@ -43,7 +44,7 @@ export namespace lysa::ui {
          * @param renderer The 2D renderer.
          * @param before True when called before drawing children, false after.
          */
-        void draw(const Widget &widget, UIResource &resources, Vector2DRenderer &renderer, bool before) const override;
+        void draw(const Widget &widget, UIResource &resources, UIRenderer &renderer, bool before) const override;
 
         /**
          * Parses and applies a resource description string to a widget.
@@ -72,25 +73,29 @@ export namespace lysa::ui {
 
         float4 extractColor(const std::string &OPT, float R, float G, float B, float A = 1.0f) const;
 
-        void drawPanel(const Panel &, StyleClassicResource &, Vector2DRenderer &) const;
+        void drawPanel(const Panel &, StyleClassicResource &, UIRenderer &) const;
 
-        void drawBox(const Widget &, const StyleClassicResource &, Vector2DRenderer &, bool pushable) const;
+        void drawBox(const Widget &, const StyleClassicResource &, UIRenderer &, bool pushable) const;
 
-        void drawLine(const Line &, const StyleClassicResource &, Vector2DRenderer &) const;
+        void drawLine(const Line &, const StyleClassicResource &, UIRenderer &) const;
 
-        void drawButton(const Button &, StyleClassicResource &, Vector2DRenderer &) const;
+        void drawButton(const Button &, StyleClassicResource &, UIRenderer &) const;
 
-        void drawToggleButton(ToggleButton &, StyleClassicResource &, Vector2DRenderer &) const;
+        void drawToggleButton(ToggleButton &, StyleClassicResource &, UIRenderer &) const;
 
-        void drawText(const Text &, const StyleClassicResource &, Vector2DRenderer &) const;
+        void drawText(const Text &, const StyleClassicResource &, UIRenderer &) const;
 
-        void drawFrame(Frame &, StyleClassicResource &, Vector2DRenderer &) const;
+        void drawFrame(Frame &, StyleClassicResource &, UIRenderer &) const;
 
-        void drawTextEdit(const TextEdit&, Vector2DRenderer&) const;
+        void drawTextEdit(const TextEdit&, UIRenderer&) const;
 
-        void drawSelection(const Selection &, const StyleClassicResource &, Vector2DRenderer &) const;
+        void drawTextArea(const TextArea&, UIRenderer&) const;
 
-        void drawProgressBar(const ProgressBar &, const StyleClassicResource &, Vector2DRenderer &) const;
+        void drawSelection(const Selection &, const StyleClassicResource &, UIRenderer &) const;
+
+        void drawProgressBar(const ProgressBar &, const StyleClassicResource &, UIRenderer &) const;
+
+        void drawTreeViewRow(const TreeView::Row &, const StyleClassicResource &, UIRenderer &) const;
 
         /*void drawArrow(GArrow&, GLayoutVectorResource&, VectorRenderer&);
         void drawCheckmark(GCheckmark&, GLayoutVectorResource&, VectorRenderer&);
@@ -24,11 +24,7 @@ namespace lysa::ui {
             float w, h;
             getSize(w, h);
             setSize(w, h);
-            if (parent) {
-                parent->refresh();
-            } else {
-                refresh();
-            }
+            invalidatePaint();
         }
     }
 
@@ -38,25 +34,19 @@ namespace lysa::ui {
             float w, h;
             getSize(w, h);
             setSize(w, h);
-            if (parent) {
-                parent->refresh();
-            } else {
-                refresh();
-            }
+            invalidatePaint();
         }
     }
 
     void Text::setTextColor(const float4 &c) {
         textColor = c;
         if (window) {
-            refresh();
+            invalidatePaint();
         }
     }
 
     void Text::getSize(float &width, float &height) const {
-        const auto& font = getFont();
-        const auto scale = getFontScale();
-        font->getSize(text, scale, width, height);
+        measureText(text, width, height);
         if (window) {
             width /= static_cast<Window*>(window)->getAspectRatio();
         }
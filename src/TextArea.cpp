@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.text_area;
+
+import std;
+import lysa.input;
+import lysa.resources.font;
+import lysa.ui.alignment;
+
+namespace lysa::ui {
+
+    TextArea::TextArea(const std::string& text) :
+        Widget{TEXTAREA},
+        text{text} {
+        allowFocus = true;
+        consumeMouseEvent = true;
+    }
+
+    void TextArea::setResources(const std::string& resBox, const std::string& resScroll) {
+        if (box == nullptr) {
+            box = std::make_shared<Box>();
+            vScroll = std::make_shared<VScrollBar>(0.0f, 0.0f);
+            add(vScroll, Alignment::RIGHT, resScroll);
+            add(box, Alignment::FILL, resBox);
+            box->setDrawBackground(false);
+            box->setClipChildren(true);
+            vScroll->setStep(2);
+            if (lineHeight <= 0.0f) {
+                float width;
+                measureText("Mg", width, lineHeight);
+            }
+            UIEvent::subscribe<UIEvent::ON_MOUSE_DOWN>(*box, [this](const UIEventMouseButton& event) {
+                this->onBoxMouseDown(event);
+            });
+            UIEvent::subscribe<UIEvent::ON_VALUE_CHANGE>(*vScroll, [this](const UIEventValue& event) {
+                this->onVScrollChange(event);
+            });
+        }
+        changedFrom = 0;
+        invalidateLayout();
+    }
+
+    void TextArea::setText(const std::string& newText) {
+        text.assign(newText);
+        caretLine = 0;
+        caretColumn = 0;
+        if (vScroll) { vScroll->setValue(0.0f); }
+        textChanged(0);
+        UIEvent::push<UIEvent::ON_TEXT_CHANGE>(id, UIEventText{});
+    }
+
+    void TextArea::insert(const size_t position, const std::string& newText) {
+        const auto at = std::min(position, text.size());
+        const auto caret = getCaretPosition();
+        text.insert(at, newText);
+        // The caret stays on the same character
+        if (caret >= at) {
+            setCaretPosition(caret + newText.size());
+        }
+        textChanged(text.getLineAt(at));
+        UIEvent::push<UIEvent::ON_TEXT_CHANGE>(id, UIEventText{});
+    }
+
+    void TextArea::erase(const size_t position, const size_t count) {
+        if (position >= text.size()) { return; }
+        const auto erased = std::min(count, text.size() - position);
+        const auto caret = getCaretPosition();
+        text.erase(position, erased);
+        if (caret > position) {
+            setCaretPosition(caret - std::min(erased, caret - position));
+        }
+        textChanged(text.getLineAt(position));
+        UIEvent::push<UIEvent::ON_TEXT_CHANGE>(id, UIEventText{});
+    }
+
+    void TextArea::setCaret(const size_t line, const size_t column) {
+        caretLine = std::min(line, text.getLineCount() - 1);
+        caretColumn = std::min(column, text.getLineLength(caretLine));
+        scrollToCaret();
+        invalidatePaint();
+    }
+
+    void TextArea::setCaretPosition(const size_t position) {
+        const auto at = std::min(position, text.size());
+        caretLine = text.getLineAt(at);
+        caretColumn = at - text.getLineStart(caretLine);
+    }
+
+    void TextArea::setLineHeight(const float height) {
+        lineHeight = height;
+        changedFrom = 0;
+        invalidateLayout();
+    }
+
+    std::shared_ptr<Text> TextArea::getLineWidget(const size_t line) const {
+        if (rows.empty()) { return nullptr; }
+        const auto slot = line % rows.size();
+        return rowsLine[slot] == line ? rows[slot] : nullptr;
+    }
+
+    float TextArea::getCaretOffset() const {
+        const auto& font = getFont();
+        const auto scale = getFontScale();
+        if ((caretAdvancesLine != caretLine) || (caretAdvancesFont != font.get()) || (caretAdvancesScale != scale)) {
+            const auto content = text.getLine(caretLine);
+            std::vector<float> all(content.size());
+            for (size_t i = 0; i < all.size(); i++) {
+                all[i] = font->getGlyphInfo(content[i]).advance * scale * font->getFontSize();
+            }
+            caretAdvances.clear();
+            caretAdvances.insert(0, all);
+            caretAdvancesLine = caretLine;
+            caretAdvancesFont = font.get();
+            caretAdvancesScale = scale;
+        }
+        return caretAdvances.prefix(static_cast<int32>(std::min(caretColumn, static_cast<size_t>(caretAdvances.size()))));
+    }
+
+    void TextArea::textChanged(const size_t line) {
+        changedFrom = std::min(changedFrom, line);
+        // The lines can have moved : the advances of the caret line are computed again
+        caretAdvancesLine = NO_LINE;
+        computeSizes();
+        scrollToCaret();
+        updateRows();
+        invalidatePaint();
+    }
+
+    void TextArea::computeSizes() {
+        if (box == nullptr) { return; }
+        innerHeight = box->getHeight() - box->getVBorder() * 2;
+        const auto linesHeight = static_cast<float>(text.getLineCount()) * lineHeight;
+        vScroll->setMax(std::max(0.0f, linesHeight - innerHeight) + vScroll->getStep());
+    }
+
+    void TextArea::scrollToCaret() {
+        if (box == nullptr) { return; }
+        const auto top = static_cast<float>(caretLine) * lineHeight;
+        const auto scroll = vScroll->getValue();
+        if (top < scroll) {
+            vScroll->setValue(top);
+        } else if ((top + lineHeight) > (scroll + innerHeight)) {
+            vScroll->setValue(top + lineHeight - innerHeight);
+        }
+    }
+
+    void TextArea::updateRows() {
+        if ((box == nullptr) || (lineHeight <= 0.0f)) { return; }
+        const auto count = static_cast<int32>(text.getLineCount());
+        const auto scroll = vScroll->getValue();
+        const auto first = std::max(0, static_cast<int32>(scroll / lineHeight) - VIRTUAL_LINES_MARGIN);
+        const auto last = std::min(
+            count,
+            static_cast<int32>((scroll + innerHeight) / lineHeight) + 1 + VIRTUAL_LINES_MARGIN);
+        const auto needed = static_cast<size_t>(std::max(0, last - first));
+        if (rows.size() < needed) {
+            // The slot of each line depends on the pool size : every row must be bound again
+            while (rows.size() < needed) {
+                rows.push_back(box->create<Text>(Alignment::NONE, ""));
+                rowsLine.push_back(NO_LINE);
+            }
+            std::ranges::fill(rowsLine, NO_LINE);
+        }
+        if (rows.empty()) { return; }
+        const auto left = box->getRect().x + box->getHBorder();
+        const auto top = box->getRect().y + box->getVBorder() - scroll;
+        std::vector displayed(rows.size(), false);
+        for (auto index = first; index < last; index++) {
+            const auto line = static_cast<size_t>(index);
+            const auto slot = line % rows.size();
+            auto& row = *rows[slot];
+            // Unchanged lines keep their recorded draw sessions
+            if ((rowsLine[slot] != line) || (line >= changedFrom)) {
+                row.setText(text.getLine(line));
+                rowsLine[slot] = line;
+            }
+            row.setPos(left, top + static_cast<float>(index) * lineHeight);
+            row.setVisible(true);
+            displayed[slot] = true;
+        }
+        for (size_t slot = 0; slot < rows.size(); slot++) {
+            if (!displayed[slot]) {
+                rows[slot]->setVisible(false);
+                rowsLine[slot] = NO_LINE;
+            }
+        }
+        changedFrom = NO_LINE;
+    }
+
+    void TextArea::eventLayout() {
+        computeSizes();
+        updateRows();
+    }
+
+    bool TextArea::eventTextInput(const std::string& newText) {
+        const auto consumed = Widget::eventTextInput(newText);
+        if (isReadOnly()) { return consumed; }
+        insert(getCaretPosition(), newText);
+        return true;
+    }
+
+    bool TextArea::eventKeyDown(const Key key) {
+        const auto consumed = Widget::eventKeyDown(key);
+        if (isReadOnly()) { return false; }
+        const auto lastLine = text.getLineCount() - 1;
+        const auto pageLines = lineHeight > 0.0f ? static_cast<size_t>(innerHeight / lineHeight) : size_t{1};
+        if (key == KEY_LEFT) {
+            if (caretColumn > 0) {
+                setCaret(caretLine, caretColumn - 1);
+            } else if (caretLine > 0) {
+                setCaret(caretLine - 1, text.getLineLength(caretLine - 1));
+            }
+        }
+        else if (key == KEY_RIGHT) {
+            if (caretColumn < text.getLineLength(caretLine)) {
+                setCaret(caretLine, caretColumn + 1);
+            } else if (caretLine < lastLine) {
+                setCaret(caretLine + 1, 0);
+            }
+        }
+        else if (key == KEY_UP) {
+            if (caretLine > 0) { setCaret(caretLine - 1, caretColumn); }
+        }
+        else if (key == KEY_DOWN) {
+            if (caretLine < lastLine) { setCaret(caretLine + 1, caretColumn); }
+        }
+        else if (key == KEY_PAGE_UP) {
+            setCaret(caretLine - std::min(caretLine, pageLines), caretColumn);
+        }
+        else if (key == KEY_PAGE_DOWN) {
+            setCaret(std::min(lastLine, caretLine + pageLines), caretColumn);
+        }
+        else if (key == KEY_HOME) {
+            setCaret(caretLine, 0);
+        }
+        else if (key == KEY_END) {
+            setCaret(caretLine, text.getLineLength(caretLine));
+        }
+        else if (key == KEY_ENTER) {
+            insert(getCaretPosition(), "\n");
+        }
+        else if (key == KEY_BACKSPACE) {
+            if (const auto position = getCaretPosition(); position > 0) {
+                erase(position - 1, 1);
+            }
+        }
+        else if (key == KEY_DELETE) {
+            erase(getCaretPosition(), 1);
+        }
+        else {
+            return consumed;
+        }
+        return true;
+    }
+
+    void TextArea::onBoxMouseDown(const UIEventMouseButton& event) {
+        box->setPushed(false);
+        if (lineHeight <= 0.0f) { return; }
+        const auto y = event.y - (box->getRect().y + box->getVBorder()) + vScroll->getValue();
+        const auto line = y <= 0.0f ? size_t{0} : static_cast<size_t>(y / lineHeight);
+        // Column of the first character whose middle is after the pointer
+        const auto& font = getFont();
+        const auto scale = getFontScale() * font->getFontSize();
+        const auto content = text.getLine(std::min(line, text.getLineCount() - 1));
+        auto x = box->getRect().x + box->getHBorder();
+        size_t column = 0;
+        for (; column < content.size(); column++) {
+            const auto advance = font->getGlyphInfo(content[column]).advance * scale;
+            if (event.x < (x + advance / 2)) { break; }
+            x += advance;
+        }
+        setCaret(line, column);
+    }
+
+    void TextArea::onVScrollChange(const UIEventValue&) {
+        // Only the displayed lines are moved, no layout of the box content
+        updateRows();
+        invalidatePaint();
+    }
+
+}
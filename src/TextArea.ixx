@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.text_area;
+
+import lysa.context;
+import lysa.exception;
+import lysa.input_event;
+import lysa.resources.font;
+import lysa.types;
+import lysa.ui.box;
+import lysa.ui.event;
+import lysa.ui.prefix_sums;
+import lysa.ui.rope;
+import lysa.ui.scroll_bar;
+import lysa.ui.text;
+import lysa.ui.widget;
+
+export namespace lysa::ui {
+
+    /**
+     * An editable multi-line text widget.
+     *
+     * The text is stored in a Rope which maintains the index of the line starts. Only the
+     * lines on screen are displayed, each one by its own Text widget (and draw sessions)
+     * recycled while scrolling : an edit only updates the displayed lines it changed.
+     * Lines are not wrapped. The OnTextChange events do not carry the text, use getText().
+     */
+    class TextArea : public Widget {
+    public:
+        //! Number of lines created above & below the displayed ones.
+        static constexpr int32 VIRTUAL_LINES_MARGIN{2};
+
+        /**
+         * Constructor.
+         * @param text Initial text.
+         */
+        TextArea(const std::string& text = "");
+
+        /**
+         * Sets the UI resources for the text area.
+         * @param resBox Resource for the background box.
+         * @param resScroll Resource for the scroll bar.
+         */
+        void setResources(const std::string& resBox, const std::string& resScroll);
+
+        /**
+         * Returns true if the widget is read-only.
+         */
+        auto isReadOnly() const { return readonly; }
+
+        /**
+         * Sets whether the widget is read-only.
+         */
+        void setReadOnly(const bool state) { readonly = state; }
+
+        /**
+         * Replaces the text, moving the caret to the start.
+         */
+        void setText(const std::string& text);
+
+        /**
+         * Returns the text.
+         */
+        std::string getText() const { return text.str(); }
+
+        /**
+         * Returns the number of lines.
+         */
+        size_t getLineCount() const { return text.getLineCount(); }
+
+        /**
+         * Returns a line, without the line break.
+         */
+        std::string getLine(const size_t line) const { return text.getLine(line); }
+
+        /**
+         * Inserts text at a position.
+         */
+        void insert(size_t position, const std::string& newText);
+
+        /**
+         * Removes `count` characters starting at a position.
+         */
+        void erase(size_t position, size_t count);
+
+        /**
+         * Moves the caret, scrolling to make it visible.
+         */
+        void setCaret(size_t line, size_t column);
+
+        /**
+         * Returns the line of the caret.
+         */
+        auto getCaretLine() const { return caretLine; }
+
+        /**
+         * Returns the column of the caret in its line.
+         */
+        auto getCaretColumn() const { return caretColumn; }
+
+        /**
+         * Returns the position of the caret in the text.
+         */
+        size_t getCaretPosition() const { return text.getLineStart(caretLine) + caretColumn; }
+
+        /**
+         * Changes the height of the lines, in UI units. Defaults to the height of a line of text.
+         */
+        void setLineHeight(float height);
+
+        /**
+         * Returns the height of the lines, in UI units.
+         */
+        auto getLineHeight() const { return lineHeight; }
+
+        /**
+         * Returns the widget displaying a line, or nullptr if the line is not on screen.
+         */
+        std::shared_ptr<Text> getLineWidget(size_t line) const;
+
+        /**
+         * Returns the horizontal position of the caret relative to the start of its line, in UI units.
+         */
+        float getCaretOffset() const;
+
+    private:
+        static constexpr size_t NO_LINE{std::numeric_limits<size_t>::max()};
+
+        Rope text;
+        bool readonly{false};
+        size_t caretLine{0};
+        size_t caretColumn{0};
+        float lineHeight{0.0f};
+        float innerHeight{0.0f};
+        // First line whose content or index changed since the last rows update
+        size_t changedFrom{0};
+        // Recycled line widgets, line `index` is displayed by rows[index % rows.size()]
+        std::vector<std::shared_ptr<Text>> rows;
+        // Line displayed by each row, or NO_LINE
+        std::vector<size_t> rowsLine;
+        std::shared_ptr<Box> box;
+        std::shared_ptr<VScrollBar> vScroll;
+        // Horizontal advance of each character of the caret line, computed on the first use after a change
+        mutable PrefixSums caretAdvances;
+        mutable size_t caretAdvancesLine{NO_LINE};
+        mutable const Font* caretAdvancesFont{nullptr};
+        mutable float caretAdvancesScale{0.0f};
+
+        // Moves the caret to a position in the text
+        void setCaretPosition(size_t position);
+
+        // Creates, binds & places the displayed rows
+        void updateRows();
+
+        // Updates the scroll bar range
+        void computeSizes();
+
+        // Scrolls to make the caret line visible
+        void scrollToCaret();
+
+        // Updates the displayed lines after an edit starting at `line`
+        void textChanged(size_t line);
+
+        void eventLayout() override;
+
+        bool eventKeyDown(Key key) override;
+
+        bool eventTextInput(const std::string& newText) override;
+
+        void onBoxMouseDown(const UIEventMouseButton& event);
+
+        // Scroll handler bound to vScroll OnValueChange.
+        void onVScrollChange(const UIEventValue& event);
+    };
+}
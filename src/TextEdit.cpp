@@ -20,35 +20,91 @@ namespace lysa::ui {
         consumeMouseEvent = true;
     }
 
-    void TextEdit::computeNDispChar() {
-        auto s = box->getWidth() - box->getHBorder() * 2 - box->getPadding() * 2;
+    float TextEdit::getAdvance(const char c) const {
+        const auto& font = getFont();
+        return font->getGlyphInfo(c).advance * textBox->getFontScale() * font->getFontSize();
+    }
+
+    float TextEdit::getCaretOffset() const {
+        if (advancesFont == nullptr) { return 0.0f; }
+        const auto caret = std::min(static_cast<int32>(selStart), advances.size());
+        return advances.prefix(caret) - advances.prefix(std::min(static_cast<int32>(startPos), caret));
+    }
+
+    void TextEdit::updateAdvances() {
+        const auto* font = getFont().get();
         const auto scale = textBox->getFontScale();
-        uint32 i;
-        for (i = startPos; (i < text.size()) && (s > 0); i++) {
-            const auto width = getFont()->getGlyphInfo(text[i]).advance * scale * getFont()->getFontSize();
-            if (s < width) { break; }
-            s -= width;
+        if ((font == advancesFont) && (scale == advancesScale)) { return; }
+        advancesFont = font;
+        advancesScale = scale;
+        std::vector<float> all(text.size());
+        for (size_t i = 0; i < all.size(); i++) {
+            all[i] = getAdvance(text[i]);
         }
-        nDispChar = i - startPos;
+        advances.clear();
+        advances.insert(0, all);
+    }
+
+    void TextEdit::insertText(const uint32 index, const std::string_view newText) {
+        text.insert(index, newText);
+        textRevision += 1;
+        if (advancesFont == nullptr) { return; }
+        std::vector<float> inserted(newText.size());
+        for (size_t i = 0; i < inserted.size(); i++) {
+            inserted[i] = getAdvance(newText[i]);
+        }
+        advances.insert(static_cast<int32>(index), inserted);
+    }
+
+    void TextEdit::eraseText(const uint32 index, const uint32 count) {
+        text.erase(index, count);
+        textRevision += 1;
+        if (advancesFont == nullptr) { return; }
+        advances.erase(static_cast<int32>(index), static_cast<int32>(count));
+    }
+
+    void TextEdit::updateDisplay() {
+        if (textBox == nullptr) { return; }
+        updateAdvances();
+        const auto width = box->getWidth() - box->getHBorder() * 2 - box->getPadding() * 2;
+        // First character such as the characters [result, end) fit in the width
+        const auto firstFitting = [&](const uint32 end) {
+            const auto target = advances.prefix(static_cast<int32>(end)) - width;
+            if (target <= 0.0f) { return uint32{0}; }
+            auto first = static_cast<uint32>(advances.find(target));
+            if (advances.prefix(static_cast<int32>(first)) < target) { first++; }
+            return std::min(first, end);
+        };
+        const auto size = static_cast<uint32>(text.size());
+        selStart = std::min(selStart, size);
+        startPos = std::min(startPos, size);
+        if ((advances.total() - advances.prefix(static_cast<int32>(startPos))) < width) {
+            // Displays as much of the end of the text as possible
+            startPos = firstFitting(size);
+        }
+        if (selStart < startPos) {
+            startPos = selStart;
+        } else {
+            startPos = std::max(startPos, firstFitting(std::min(selStart + selLen, size)));
+        }
+        const auto start = advances.prefix(static_cast<int32>(startPos));
+        nDispChar = static_cast<uint32>(advances.find(start + std::max(0.0f, width))) - startPos;
+        textBox->setText(text.substr(startPos, nDispChar));
     }
 
     void TextEdit::setText(const std::string& TEXT) {
-        if (text == TEXT) return;
+        if (text.size() == TEXT.size() && text.str() == TEXT) return;
         if (text.empty()) {
             selStart = 0;
             startPos = 0;
         }
-        text = TEXT;
-        computeNDispChar();
-        if (parent) { parent->refresh(); }
-        if ((startPos + nDispChar) >= text.size()) {
-            startPos = 0;
-        }
-        // Log::info(text, " : " , text.size(), " - " , startPos, " - ", nDispChar);
-        textBox->setText(text.substr(startPos, nDispChar));
-        box->refresh();
-        refresh();
-        ctx().events.push({UIEvent::OnTextChange, UIEventText{.text = text}, id});
+        text.assign(TEXT);
+        textRevision += 1;
+        // Computes all the advances on the next display update
+        advancesFont = nullptr;
+        updateDisplay();
+        invalidatePaint();
+        UIEvent::push<UIEvent::ON_TEXT_CHANGE>(id, UIEventText{.text = TEXT});
     }
 
     void TextEdit::setSelStart(const uint32 start) {
@@ -61,12 +117,15 @@ namespace lysa::ui {
     void TextEdit::setResources(const std::string& resource) {
         if (box == nullptr) {
             box = create<Box>(resource + ",LOWERED", Alignment::FILL);
-            textBox = box->create<Text>(Alignment::HCENTER, text);
+            textBox = box->create<Text>(Alignment::HCENTER, text.str());
         }
         selStart = 0;
         startPos = 0;
-        computeNDispChar();
-        textBox->setText(text.substr(0, nDispChar));
+        updateDisplay();
+    }
+
+    void TextEdit::eventLayout() {
+        updateDisplay();
     }
 
     bool TextEdit::eventTextInput(const std::string& newText) {
@@ -74,23 +133,13 @@ namespace lysa::ui {
         if (isReadOnly()) { return consumed; }
 
         setFreezed(true);
-        setText(text.substr(0, selStart) + newText +
-                       text.substr(selStart, text.size() - selStart));
-        ctx().events.push({UIEvent::OnTextChange, UIEventText{.text = text}, id});
-        selStart++;
-        computeNDispChar();
-        if (selStart < startPos) {
-            startPos = selStart;
-        }
-        else if (((selStart + selLen) > (startPos + nDispChar)) &&
-            (nDispChar != text.length())) {
-            startPos = selStart - nDispChar;
-        }
-        computeNDispChar();
+        selStart = std::min(selStart, static_cast<uint32>(text.size()));
+        insertText(selStart, newText);
+        selStart += static_cast<uint32>(newText.size());
+        updateDisplay();
         setFreezed(false);
-        textBox->setText(text.substr(startPos, nDispChar));
-        box->refresh();
-        refresh();
+        invalidatePaint();
+        UIEvent::push<UIEvent::ON_TEXT_CHANGE>(id, UIEventText{.text = text.str()});
         return true;
     }
 
@@ -99,14 +148,15 @@ namespace lysa::ui {
         if (isReadOnly()) { return false; }
 
         setFreezed(true);
+        auto changed = false;
         if (key == KEY_LEFT) {
             if (selStart > 0) { selStart--; }
         }
         else if (key == KEY_RIGHT) {
-            if (selStart < text.length()) { selStart++; }
+            if (selStart < text.size()) { selStart++; }
         }
         else if (key == KEY_END) {
-            selStart = text.length();
+            selStart = text.size();
         }
         else if (key == KEY_HOME) {
             selStart = 0;
@@ -114,32 +164,25 @@ namespace lysa::ui {
         else if (key == KEY_BACKSPACE) {
             if (selStart > 0) {
                 selStart--;
-                setText(text.substr(0, selStart) + text.substr(selStart + 1,
-                                                               text.length() - selStart - 1));
+                eraseText(selStart, 1);
+                changed = true;
             }
         }
         else if (key == KEY_DELETE) {
-            if (selStart < text.length()) {
-                setText(text.substr(0, selStart) + text.substr(selStart + 1,
-                                                               text.length() - selStart - 1));
+            if (selStart < text.size()) {
+                eraseText(selStart, 1);
+                changed = true;
             }
         } else {
             setFreezed(false);
             return consumed;
         }
-        computeNDispChar();
-        if (selStart < startPos) {
-            startPos = selStart;
-        }
-        else if (((selStart + selLen) > (startPos + nDispChar)) &&
-            (nDispChar != text.length())) {
-            startPos = selStart - nDispChar;
-        }
-        computeNDispChar();
+        updateDisplay();
         setFreezed(false);
-        textBox->setText(text.substr(startPos, nDispChar));
-        box->refresh();
-        refresh();
+        invalidatePaint();
+        if (changed) {
+            UIEvent::push<UIEvent::ON_TEXT_CHANGE>(id, UIEventText{.text = text.str()});
+        }
         return true;
     }
 }
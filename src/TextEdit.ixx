@@ -9,9 +9,12 @@ export module lysa.ui.text_edit;
 import lysa.context;
 import lysa.exception;
 import lysa.input_event;
+import lysa.resources.font;
 import lysa.types;
 import lysa.ui.box;
 import lysa.ui.event;
+import lysa.ui.gap_buffer;
+import lysa.ui.prefix_sums;
 import lysa.ui.text;
 import lysa.ui.widget;
 
@@ -19,6 +22,10 @@ export namespace lysa::ui {
 
     /**
      * An editable single line of text widget.
+     *
+     * The text is stored in a gap buffer, together with the cumulative advances of the
+     * characters : editing at the caret, placing the caret and scrolling the displayed
+     * part do not walk the whole text.
      */
     class TextEdit : public Widget {
     public:
@@ -51,7 +58,12 @@ export namespace lysa::ui {
         /**
          * Returns the text.
          */
-        auto getText() const { return text; }
+        std::string getText() const { return text.str(); }
+
+        /**
+         * Returns a counter incremented at each change of the text.
+         */
+        auto getTextRevision() const { return textRevision; }
 
         /**
          * Returns the selection start position.
@@ -63,6 +75,11 @@ export namespace lysa::ui {
          */
         auto getFirstDisplayedChar() const { return startPos; }
 
+        /**
+         * Returns the horizontal position of the caret relative to the displayed text, in UI units.
+         */
+        float getCaretOffset() const;
+
         /**
          * Returns the text currently being displayed in the text box.
          */
@@ -79,7 +96,13 @@ export namespace lysa::ui {
         void setResources(const std::string& resource);
 
     protected:
-        std::string text;
+        GapBuffer text;
+        uint32 textRevision{0};
+        // Horizontal advance of each character of the text
+        PrefixSums advances;
+        // Font & scale used to compute the advances
+        const Font* advancesFont{nullptr};
+        float advancesScale{0.0f};
         bool readonly{false};
         uint32 selStart{0};
         uint32 selLen{0};
@@ -92,7 +115,21 @@ export namespace lysa::ui {
 
         bool eventTextInput(const std::string& newText) override;
 
-        // Compute the number of displayed characters
-        void computeNDispChar();
+        void eventLayout() override;
+
+        // Inserts characters in the text & their advances
+        void insertText(uint32 index, std::string_view newText);
+
+        // Removes characters from the text & their advances
+        void eraseText(uint32 index, uint32 count);
+
+        // Returns the horizontal advance of a character
+        float getAdvance(char c) const;
+
+        // Computes the advances of all the characters if the font or the scale changed
+        void updateAdvances();
+
+        // Scrolls to the caret, computes the number of displayed characters & updates the text box
+        void updateDisplay();
     };
 }
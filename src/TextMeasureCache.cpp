@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.text_measure_cache;
+
+namespace lysa::ui {
+
+    size_t TextMeasureCache::KeyHash::operator()(const KeyView& key) const {
+        auto hash = std::hash<std::string_view>{}(key.text);
+        hash ^= std::hash<const Font*>{}(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<float>{}(key.scale) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    TextMeasureCache::TextMeasureCache(const size_t capacity):
+        capacity{capacity} {
+    }
+
+    void TextMeasureCache::getSize(
+        const std::shared_ptr<Font>& font,
+        const float scale,
+        const std::string& text,
+        float& width,
+        float& height) {
+        const auto it = entries.find(KeyView{font.get(), scale, text});
+        if (it != entries.end()) {
+            auto& entry = it->second;
+            if (!entry.font.expired()) {
+                stats.hits += 1;
+                usage.splice(usage.begin(), usage, entry.usage);
+                width = entry.width;
+                height = entry.height;
+                return;
+            }
+            // The font at this address has been destroyed and replaced
+            usage.erase(entry.usage);
+            entries.erase(it);
+        }
+        stats.misses += 1;
+        font->getSize(text, scale, width, height);
+        if (capacity == 0) { return; }
+        if (entries.size() >= capacity) {
+            evict(entries.size() - capacity + 1);
+        }
+        const auto [inserted, _] = entries.emplace(
+            Key{font.get(), scale, text},
+            Entry{font, width, height, {}});
+        usage.push_front(&inserted->first);
+        inserted->second.usage = usage.begin();
+    }
+
+    void TextMeasureCache::invalidate(const Font& font) {
+        std::erase_if(entries, [&](const auto& entry) {
+            if (entry.first.font != &font) { return false; }
+            usage.erase(entry.second.usage);
+            return true;
+        });
+    }
+
+    void TextMeasureCache::clear() {
+        entries.clear();
+        usage.clear();
+    }
+
+    void TextMeasureCache::setCapacity(const size_t capacity) {
+        this->capacity = capacity;
+        if (entries.size() > capacity) {
+            evict(entries.size() - capacity);
+        }
+    }
+
+    void TextMeasureCache::evict(const size_t count) {
+        for (size_t i = 0; (i < count) && !usage.empty(); i++) {
+            const auto* key = usage.back();
+            usage.pop_back();
+            entries.erase(entries.find(*key));
+            stats.evictions += 1;
+        }
+    }
+
+}
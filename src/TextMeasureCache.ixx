@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.text_measure_cache;
+
+import std;
+import lysa.resources.font;
+import lysa.types;
+
+export namespace lysa::ui {
+
+    /**
+     * Least recently used cache of the sizes of the texts measured by the widgets & the styles.
+     *
+     * The sizes are keyed on the font, the font scale and the text : changing the font or
+     * the scale of a widget uses other entries, and the entries of a destroyed font are never
+     * returned. One cache is shared by all the windows of a WindowManager.
+     */
+    class TextMeasureCache {
+    public:
+        /**
+         * Counters accumulated since the creation or the last call to resetStats().
+         */
+        struct Stats {
+            //! Number of sizes found in the cache
+            uint64 hits{0};
+            //! Number of sizes measured with the font
+            uint64 misses{0};
+            //! Number of least recently used entries removed to make room
+            uint64 evictions{0};
+
+            /**
+             * Returns the ratio of the lookups found in the cache, between 0 and 1.
+             */
+            double getHitRate() const {
+                return (hits + misses) == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+            }
+        };
+
+        //! Default maximum number of entries
+        static constexpr size_t DEFAULT_CAPACITY{4096};
+
+        /**
+         * Creates an empty cache.
+         * @param capacity Maximum number of entries.
+         */
+        TextMeasureCache(size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * Returns the size of a text, measured with Font::getSize() if not in the cache.
+         * @param font The font used to draw the text.
+         * @param scale The font scale.
+         * @param text The text to measure.
+         * @param width Output width.
+         * @param height Output height.
+         */
+        void getSize(const std::shared_ptr<Font>& font, float scale, const std::string& text, float& width, float& height);
+
+        /**
+         * Removes all the entries of a font.
+         */
+        void invalidate(const Font& font);
+
+        /**
+         * Removes all the entries.
+         */
+        void clear();
+
+        /**
+         * Returns the number of entries.
+         */
+        size_t size() const { return entries.size(); }
+
+        /**
+         * Returns the maximum number of entries.
+         */
+        size_t getCapacity() const { return capacity; }
+
+        /**
+         * Changes the maximum number of entries, evicting the least recently used ones if needed.
+         */
+        void setCapacity(size_t capacity);
+
+        /**
+         * Returns the counters accumulated since the last call to resetStats().
+         */
+        const Stats& getStats() const { return stats; }
+
+        /**
+         * Resets the counters.
+         */
+        void resetStats() { stats = {}; }
+
+    private:
+        struct Key {
+            const Font* font;
+            float scale;
+            std::string text;
+        };
+
+        // Lookup key, avoids copying the text for the lookups
+        struct KeyView {
+            const Font* font;
+            float scale;
+            std::string_view text;
+        };
+
+        struct KeyHash {
+            using is_transparent = void;
+            size_t operator()(const KeyView& key) const;
+            size_t operator()(const Key& key) const { return (*this)(KeyView{key.font, key.scale, key.text}); }
+        };
+
+        struct KeyEqual {
+            using is_transparent = void;
+            static KeyView view(const Key& key) { return {key.font, key.scale, key.text}; }
+            static KeyView view(const KeyView& key) { return key; }
+            bool operator()(const auto& a, const auto& b) const {
+                const auto va = view(a);
+                const auto vb = view(b);
+                return (va.font == vb.font) && (va.scale == vb.scale) && (va.text == vb.text);
+            }
+        };
+
+        struct Entry {
+            // Detects a new font allocated at the address of a destroyed one
+            std::weak_ptr<Font> font;
+            float width;
+            float height;
+            // Position in the usage order
+            std::list<const Key*>::iterator usage;
+        };
+
+        size_t capacity;
+        std::unordered_map<Key, Entry, KeyHash, KeyEqual> entries;
+        // Keys of the entries, most recently used first
+        std::list<const Key*> usage;
+        Stats stats;
+
+        void evict(size_t count);
+    };
+
+}
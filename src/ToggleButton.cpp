@@ -19,7 +19,7 @@ namespace lysa::ui {
     bool ToggleButton::eventMouseUp(const MouseButton button, const float x, const float y)  {
         CheckWidget::eventMouseUp(button, x, y);
         if (getRect().contains(x, y)) {
-            ctx().events.push({UIEvent::OnClick, UIEventClick{}, id});
+            UIEvent::push<UIEvent::ON_CLICK>(id, UIEventClick{});
             return true;
         }
         return false;
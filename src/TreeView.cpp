@@ -6,6 +6,7 @@
 */
 module lysa.ui.tree_view;
 
+import std;
 import lysa.ui.alignment;
 
 namespace lysa::ui {
@@ -26,81 +27,370 @@ namespace lysa::ui {
             add(box, Alignment::FILL, resBox);
             box->setDrawBackground(false);
             box->setPadding(1);
+            box->setClipChildren(true);
             vScroll->setStep(2);
-            ctx().events.subscribe(UIEvent::OnValueChange, vScroll->id, [this](auto evt) {
-                this->onVScrollChange(std::any_cast<UIEventValue>(evt.payload));
+            if (rowHeight <= 0.0f) {
+                float width;
+                measureText("Mg", width, rowHeight);
+            }
+            UIEvent::subscribe<UIEvent::ON_MOUSE_DOWN>(*box, [this](const UIEventMouseButton& event) {
+                this->onBoxMouseDown(event);
+            });
+            UIEvent::subscribe<UIEvent::ON_VALUE_CHANGE>(*vScroll, [this](const UIEventValue& event) {
+                this->onVScrollChange(event);
             });
         }
     }
 
+    void TreeView::setIndent(const float indent) {
+        this->indent = indent;
+        invalidateLayout();
+    }
+
+    void TreeView::setRowHeight(const float height) {
+        rowHeight = height;
+        computeSizes();
+        invalidateLayout();
+    }
+
     void TreeView::removeAllItems() {
-        box->removeAll();
+        unbindRows();
         items.clear();
+        visible.clear();
+        visibleDirty = false;
         computeSizes();
+        invalidateLayout();
     }
 
     std::shared_ptr<TreeView::Item>& TreeView::addItem(std::shared_ptr<Widget> item) {
-        items.push_back(std::make_shared<Item>(item));
-        auto& newWidget = items.back();
-        box->add(newWidget, Alignment::TOPLEFT);
-        newWidget->handle = std::make_shared<Text>(" ");
-        newWidget->add(newWidget->handle,Alignment:: LEFT, treeTabsSize);
-        newWidget->add(item, Alignment::LEFT);
-        newWidget->setSize(1000.0f, item->getHeight());
-        newWidget->setDrawBackground(false);
+        auto& newItem = createItem(nullptr, item);
         computeSizes();
-        return newWidget;
+        invalidateLayout();
+        return newItem;
     }
 
     std::shared_ptr<TreeView::Item>& TreeView::addItem(const std::shared_ptr<Item>& parent, std::shared_ptr<Widget> item) {
-        parent->children.push_back(std::make_shared<Item>(item));
-        auto& newWidget = parent->children.back();
-        newWidget->level = parent->level + 1;
-        box->add(newWidget, Alignment::TOPLEFT);
-        for (int i = 0; i <= newWidget->level; i++) {
-            if (i == (newWidget->level)) {
-                newWidget->handle = std::make_shared<Text>(" ");
-                newWidget->add(newWidget->handle, Alignment::LEFT, treeTabsSize);
+        auto& newItem = createItem(parent.get(), item);
+        computeSizes();
+        invalidateLayout();
+        return newItem;
+    }
+
+    std::vector<std::shared_ptr<TreeView::Item>> TreeView::addItems(const std::vector<std::shared_ptr<Widget>>& newItems) {
+        std::vector<std::shared_ptr<Item>> created;
+        created.reserve(newItems.size());
+        for (const auto& item : newItems) {
+            created.push_back(createItem(nullptr, item));
+        }
+        computeSizes();
+        invalidateLayout();
+        return created;
+    }
+
+    std::vector<std::shared_ptr<TreeView::Item>> TreeView::addItems(
+        const std::shared_ptr<Item>& parent,
+        const std::vector<std::shared_ptr<Widget>>& newItems) {
+        std::vector<std::shared_ptr<Item>> created;
+        if (newItems.empty()) { return created; }
+        created.reserve(newItems.size());
+        // Inserts all the new visible rows at once instead of one insertion per item
+        const auto shown = !visibleDirty && parent->expanded && isShown(*parent);
+        const auto wasExpanded = parent->expanded;
+        const auto end = shown ? getVisibleEnd(getVisibleIndex(*parent)) : 0;
+        parent->expanded = false;
+        for (const auto& item : newItems) {
+            created.push_back(createItem(parent.get(), item));
+        }
+        parent->expanded = wasExpanded;
+        if (shown) {
+            std::vector<Item*> inserted;
+            inserted.reserve(created.size());
+            for (const auto& item : created) {
+                inserted.push_back(item.get());
+            }
+            visible.insert(visible.begin() + end, inserted.begin(), inserted.end());
+            indexVisible(end);
+        }
+        computeSizes();
+        invalidateLayout();
+        return created;
+    }
+
+    void TreeView::removeItems(const std::vector<std::shared_ptr<Item>>& removed) {
+        if (removed.empty()) { return; }
+        std::unordered_set<const Item*> removedSet;
+        std::unordered_set<Item*> parents;
+        const std::function<void(const Item&)> collect = [&](const Item& item) {
+            for (const auto& child : item.children) {
+                removedSet.insert(child.get());
+                collect(*child);
+            }
+        };
+        for (const auto& item : removed) {
+            if (!removedSet.insert(item.get()).second) { continue; }
+            if (item->parentItem) { parents.insert(item->parentItem); }
+            collect(*item);
+        }
+        unbindRows();
+        std::erase_if(visible, [&](const Item* item) { return removedSet.contains(item); });
+        indexVisible(0);
+        const auto isRemoved = [&](const std::shared_ptr<Item>& item) { return removedSet.contains(item.get()); };
+        // The removed items are kept alive by `removed` until the end of the erasing
+        for (auto* parent : parents) {
+            if (!removedSet.contains(parent)) {
+                std::erase_if(parent->children, isRemoved);
+            }
+        }
+        std::erase_if(items, isRemoved);
+        computeSizes();
+        invalidateLayout();
+    }
+
+    std::vector<std::shared_ptr<TreeView::Item>> TreeView::replaceAll(const std::vector<std::shared_ptr<Widget>>& newItems) {
+        removeAllItems();
+        return addItems(newItems);
+    }
+
+    std::shared_ptr<TreeView::Item>& TreeView::createItem(Item* parent, const std::shared_ptr<Widget>& item) {
+        auto& siblings = parent ? parent->children : items;
+        siblings.push_back(std::make_shared<Item>(item));
+        auto& newItem = siblings.back();
+        newItem->parentItem = parent;
+        newItem->level = parent ? parent->level + 1 : 0;
+        newItem->lazy = childrenProvider != nullptr;
+        if (visibleDirty) { return newItem; }
+        if (parent == nullptr) {
+            // The last root item is always displayed at the end
+            newItem->visibleIndex = visible.size();
+            visible.push_back(newItem.get());
+        } else if (parent->expanded && isShown(*parent)) {
+            // Rebuilt once by the next layout instead of one O(n) insertion per added child
+            visibleDirty = true;
+        }
+        return newItem;
+    }
+
+    void TreeView::expand(const std::shared_ptr<Item>& item) {
+        if (item->expanded) { return; }
+        if (item->lazy) {
+            // Displays a placeholder until the provider calls childrenLoaded()
+            item->lazy = false;
+            item->loading = true;
+            item->placeholder = createItem(item.get(), std::make_shared<Text>(placeholderText));
+            item->placeholder->lazy = false;
+            if (childrenProvider) {
+                childrenProvider(item);
             }
-            else {
-                newWidget->add(std::make_shared<Panel>(), Alignment::LEFT, treeTabsSize);
+            if (item->expanded) {
+                // The provider expanded the item itself
+                return;
             }
         }
-        parent->handle->setText("-");
-        newWidget->add(item, Alignment::LEFT);
-        newWidget->setSize(1000.0f, item->getHeight());
-        newWidget->setDrawBackground(false);
-        //expand(parent->item);
+        item->expanded = true;
+        if (!visibleDirty && isShown(*item)) {
+            std::vector<Item*> shown;
+            appendVisibleChildren(*item, shown);
+            const auto index = getVisibleIndex(*item) + 1;
+            visible.insert(visible.begin() + index, shown.begin(), shown.end());
+            indexVisible(index);
+        }
         computeSizes();
-        return newWidget;
+        invalidateLayout();
     }
 
-    void TreeView::expand(const std::shared_ptr<Widget>& item) const {
-        throw Exception("not implemented");
-        // for (const auto& widget : box->_getChildren()) {
-        //     if (const auto itemWidget = dynamic_cast<Item*>(item.get())) {
-        //         if (itemWidget->item == item) {
-        //             throw Exception("not implemented");
-        //             // log("found");
-        //         }
-        //     }
-        // }
+    void TreeView::collapse(const std::shared_ptr<Item>& item) {
+        if (!item->expanded) { return; }
+        if (!visibleDirty && isShown(*item)) {
+            const auto index = getVisibleIndex(*item);
+            visible.erase(visible.begin() + index + 1, visible.begin() + getVisibleEnd(index));
+            indexVisible(index + 1);
+        }
+        item->expanded = false;
+        computeSizes();
+        invalidateLayout();
     }
 
-    void TreeView::computeSizes() {
+    void TreeView::childrenLoaded(const std::shared_ptr<Item>& item) {
+        if (!item->loading) { return; }
+        item->loading = false;
+        if (const auto placeholder = item->placeholder) {
+            item->placeholder.reset();
+            removeItems({placeholder});
+        }
+    }
+
+    bool TreeView::isShown(const Item& item) const {
+        for (auto* parent = item.parentItem; parent != nullptr; parent = parent->parentItem) {
+            if (!parent->expanded) { return false; }
+        }
+        return true;
+    }
+
+    void TreeView::indexVisible(const size_t from) const {
+        // Only the items after a change move, no search of the items in `visible`
+        for (auto index = from; index < visible.size(); index++) {
+            visible[index]->visibleIndex = index;
+        }
+    }
+
+    size_t TreeView::getVisibleEnd(const size_t index) const {
+        const auto level = visible[index]->level;
+        auto end = index + 1;
+        while ((end < visible.size()) && (visible[end]->level > level)) {
+            end++;
+        }
+        return end;
+    }
+
+    void TreeView::updateVisible() const {
+        if (!visibleDirty) { return; }
+        visible.clear();
+        for (const auto& item : items) {
+            visible.push_back(item.get());
+            appendVisibleChildren(*item, visible);
+        }
+        indexVisible(0);
+        visibleDirty = false;
+    }
+
+    int32 TreeView::getVisibleCount() const {
+        updateVisible();
+        return static_cast<int32>(visible.size());
+    }
+
+    void TreeView::appendVisibleChildren(const Item& item, std::vector<Item*>& result) const {
+        if (!item.expanded) { return; }
+        for (const auto& child : item.children) {
+            result.push_back(child.get());
+            appendVisibleChildren(*child, result);
+        }
+    }
+
+    float TreeView::getRowFullHeight() const {
+        return rowHeight + box->getPadding() * 2;
+    }
+
+    void TreeView::updateRows() {
         if (box == nullptr) { return; }
-        innerHeight = box->getHeight() - box->getVBorder() * 2;
-        itemsHeight = 0;
-        for (const auto& child : box->getChildren()) {
-            itemsHeight += child->getHeight() + box->getPadding() * 2;
+        updateVisible();
+        const auto fullHeight = getRowFullHeight();
+        if (fullHeight <= 0) { return; }
+        const auto count = static_cast<int32>(visible.size());
+        const auto scroll = vScroll->getValue();
+        const auto first = std::max(0, static_cast<int32>(scroll / fullHeight) - VIRTUAL_ROWS_MARGIN);
+        const auto last = std::min(
+            count,
+            static_cast<int32>((scroll + innerHeight) / fullHeight) + 1 + VIRTUAL_ROWS_MARGIN);
+        const auto needed = static_cast<size_t>(std::max(0, last - first));
+        if (rows.size() < needed) {
+            // The slot of each row depends on the pool size : every row must be bound again
+            unbindRows();
+            while (rows.size() < needed) {
+                rows.push_back(box->create<Row>(Alignment::NONE));
+                rows.back()->setDrawBackground(false);
+            }
+        }
+        if (rows.empty()) { return; }
+        // Item displayed by each slot
+        std::vector<Item*> displayed(rows.size(), nullptr);
+        for (auto index = first; index < last; index++) {
+            displayed[static_cast<size_t>(index) % rows.size()] = visible[index];
+        }
+        // Unbinds all the recycled rows before binding them, an item can move to another slot
+        for (size_t slot = 0; slot < rows.size(); slot++) {
+            auto& row = *rows[slot];
+            if ((row.item != displayed[slot]) && row.content) {
+                unbindRow(row);
+            }
         }
+        const auto left = box->getRect().x + box->getHBorder();
+        const auto top = box->getRect().y + box->getVBorder() + box->getPadding() - scroll;
+        const auto width = box->getWidth() - box->getHBorder() * 2;
+        for (auto index = first; index < last; index++) {
+            auto& row = *rows[static_cast<size_t>(index) % rows.size()];
+            auto* item = visible[index];
+            if (row.item != item) {
+                row.item = item;
+                // The item widget is only initialized by its first binding
+                if (!row._reattach(item->item, Alignment::NONE)) {
+                    row.add(item->item, Alignment::NONE);
+                }
+                row.content = item->item;
+            }
+            const auto handle =
+                (item->lazy || (!item->children.empty() && !item->expanded)) ? Row::COLLAPSED :
+                item->children.empty() ? Row::NONE : Row::EXPANDED;
+            const auto rowIndent = item->level * indent;
+            if ((row.handle != handle) || (row.indent != rowIndent)) {
+                row.handle = handle;
+                row.indent = rowIndent;
+                row.invalidatePaint();
+            }
+            const auto y = top + index * fullHeight;
+            row.setRect(left, y, width, rowHeight);
+            row.content->setPos(left + rowIndent + row.getHandleSize(), y);
+            row.setVisible(true);
+        }
+        for (size_t slot = 0; slot < rows.size(); slot++) {
+            if (displayed[slot] == nullptr) {
+                rows[slot]->setVisible(false);
+            }
+        }
+    }
+
+    void TreeView::unbindRow(Row& row) {
+        if (row.content) {
+            // The removed widget would be displayed at its last position
+            row.content->_resetDrawSessions();
+            row.remove(row.content);
+            row.content.reset();
+        }
+        row.item = nullptr;
+    }
+
+    void TreeView::unbindRows() {
+        for (const auto& row : rows) {
+            unbindRow(*row);
+        }
+    }
+
+    void TreeView::computeSizes() {
+        // Computed by the pending layout once the visible items are rebuilt
+        if ((box == nullptr) || visibleDirty) { return; }
+        innerHeight = box->getHeight() - box->getVBorder() * 2;
+        itemsHeight = visible.size() * getRowFullHeight();
         vScroll->setMax(itemsHeight - innerHeight + vScroll->getStep());
     }
 
-    void TreeView::onVScrollChange(const UIEventValue& event) {
-        box->setChildrenOffset(0, event.value);
-        refresh();
+    void TreeView::eventLayout() {
+        updateVisible();
+        computeSizes();
+        updateRows();
+    }
+
+    void TreeView::onBoxMouseDown(const UIEventMouseButton& event) {
+        box->setPushed(false);
+        for (const auto& row : rows) {
+            if ((row->item == nullptr) || (row->handle == Row::NONE) || !row->isVisible()) { continue; }
+            const auto& rect = row->getRect();
+            const auto handleLeft = rect.x + row->indent;
+            if (rect.contains(event.x, event.y) &&
+                (event.x >= handleLeft) && (event.x < (handleLeft + row->getHandleSize()))) {
+                const auto item = row->item->shared_from_this();
+                if (item->expanded) {
+                    collapse(item);
+                } else {
+                    expand(item);
+                }
+                return;
+            }
+        }
     }
 
+    void TreeView::onVScrollChange(const UIEventValue&) {
+        // Only the displayed rows are moved, no layout of the box content
+        updateRows();
+        invalidatePaint();
+    }
 
 }
@@ -20,24 +20,88 @@ export namespace lysa::ui {
 
     /**
      * A widget that displays a hierarchical list of items.
+     *
+     * The tree of items is kept separate from the displayed rows : the TreeView maintains a
+     * flattened array of the visible items (the items whose ancestors are all expanded),
+     * updated incrementally on expand & collapse (and rebuilt once by the next layout when
+     * children are added to a displayed item), and only creates row widgets for the
+     * rows on screen, recycling them while scrolling.
+     * All the rows have the same height, see setRowHeight().
      */
     class TreeView : public Widget {
     public:
         /**
          * An item within a TreeView.
+         * The item widget is only added to a row widget while the item is on screen.
          */
-        class Item : public Panel {
+        class Item : public std::enable_shared_from_this<Item> {
         public:
-            std::shared_ptr<Widget> item;           //! The widget displayed for this item
-            std::shared_ptr<Text> handle;           //! The expansion handle (+/-)
-            std::list<std::shared_ptr<Item>> children; //! Child items
-            int level{0};                           //! Depth level in the tree
-            bool selected{false};                   //! Whether the item is selected
-            bool expanded{false};                   //! Whether the item is expanded
+            std::shared_ptr<Widget> item;               //! The widget displayed for this item
+            std::vector<std::shared_ptr<Item>> children;//! Child items
+            Item* parentItem{nullptr};                  //! Parent item, or nullptr for a root item
+            int level{0};                               //! Depth level in the tree
+            bool selected{false};                       //! Whether the item is selected
+            bool expanded{false};                       //! Whether the item is expanded
+            bool lazy{false};                           //! Children are provided by the ChildrenProvider on first expand
+            bool loading{false};                        //! Children requested, waiting for childrenLoaded()
+            std::shared_ptr<Item> placeholder;          //! Child displayed while loading
+            size_t visibleIndex{0};                     //! Index in the visible items while shown, maintained by the TreeView
 
             Item(const std::shared_ptr<Widget>& item) : item{item} {}
         };
 
+        /**
+         * Called the first time a lazy item is expanded. The provider adds the children
+         * of the item with addItem()/addItems() then calls childrenLoaded(), either
+         * immediately or later (from the UI thread) when the children are available.
+         */
+        using ChildrenProvider = std::function<void(const std::shared_ptr<Item>& item)>;
+
+        /**
+         * Row widget displaying a visible item, recycled while scrolling.
+         * The indentation & the expand handle are drawn by the style, the item
+         * widget is placed after them.
+         */
+        class Row : public Panel {
+        public:
+            //! Expand handle of a row
+            enum Handle {
+                //! The item has no children
+                NONE,
+                //! The item can be expanded
+                COLLAPSED,
+                //! The item is expanded
+                EXPANDED,
+            };
+
+            Row(): Panel{TREEVIEWROW} {}
+
+            /**
+             * Returns the horizontal offset of the handle, in UI units.
+             */
+            auto getIndent() const { return indent; }
+
+            /**
+             * Returns the expand handle to draw.
+             */
+            auto getHandle() const { return handle; }
+
+            /**
+             * Returns the width of the handle area, in UI units.
+             */
+            auto getHandleSize() const { return getRect().height; }
+
+        private:
+            float indent{0.0f};
+            Handle handle{NONE};
+            std::shared_ptr<Widget> content;
+            Item* item{nullptr};
+            friend class TreeView;
+        };
+
+        //! Number of rows created above & below the displayed ones.
+        static constexpr int32 VIRTUAL_ROWS_MARGIN{2};
+
         /**
          * Creates a default TreeView widget.
          */
@@ -71,22 +135,144 @@ export namespace lysa::ui {
         std::shared_ptr<Item>& addItem(const std::shared_ptr<Item>& parent, std::shared_ptr<Widget> item);
 
         /**
-         * Expands a specific item.
-         * @param item The widget associated with the item to expand.
+         * Adds root items to the tree view, with a single size computation.
+         * @param newItems The widgets to add as items.
+         * @return The created tree items.
+         */
+        std::vector<std::shared_ptr<Item>> addItems(const std::vector<std::shared_ptr<Widget>>& newItems);
+
+        /**
+         * Adds child items to a parent item, with a single size computation.
+         * @param parent The parent item.
+         * @param newItems The widgets to add as child items.
+         * @return The created tree items.
          */
-        void expand(const std::shared_ptr<Widget>& item) const;
+        std::vector<std::shared_ptr<Item>> addItems(
+            const std::shared_ptr<Item>& parent,
+            const std::vector<std::shared_ptr<Widget>>& newItems);
+
+        /**
+         * Removes items and all their descendants, with a single size computation.
+         */
+        void removeItems(const std::vector<std::shared_ptr<Item>>& removed);
+
+        /**
+         * Replaces all the items of the tree view by root items.
+         * @return The created tree items.
+         */
+        std::vector<std::shared_ptr<Item>> replaceAll(const std::vector<std::shared_ptr<Widget>>& newItems);
+
+        /**
+         * Expands an item, displaying its children.
+         */
+        void expand(const std::shared_ptr<Item>& item);
+
+        /**
+         * Collapses an item, hiding all its descendants.
+         */
+        void collapse(const std::shared_ptr<Item>& item);
+
+        /**
+         * Sets the provider of the children of the lazy items.
+         * Items added while a provider is set are lazy : they are displayed as expandable
+         * and their children are requested on first expand. Set Item::lazy to false for leaves.
+         */
+        void setChildrenProvider(const ChildrenProvider& provider) { childrenProvider = provider; }
+
+        /**
+         * Signals that all the children of a lazy item have been added, removing its placeholder.
+         */
+        void childrenLoaded(const std::shared_ptr<Item>& item);
+
+        /**
+         * Changes the text of the placeholder child displayed while loading children.
+         */
+        void setPlaceholderText(const std::string& text) { placeholderText = text; }
+
+        /**
+         * Returns true if all the ancestors of an item are expanded.
+         */
+        bool isShown(const Item& item) const;
+
+        /**
+         * Returns the number of visible items (the items whose ancestors are all expanded).
+         */
+        int32 getVisibleCount() const;
+
+        /**
+         * Changes the indentation of each level of the tree, in UI units.
+         */
+        void setIndent(float indent);
+
+        /**
+         * Returns the indentation of each level of the tree, in UI units.
+         */
+        auto getIndent() const { return indent; }
+
+        /**
+         * Changes the height of the rows, in UI units. Defaults to the height of a line of text.
+         */
+        void setRowHeight(float height);
+
+        /**
+         * Returns the height of the rows, in UI units.
+         */
+        auto getRowHeight() const { return rowHeight; }
 
     private:
-        const std::string treeTabsSize{"5,5"};
+        float indent{10.0f};
         float innerHeight;
         float itemsHeight;
-        std::list<std::shared_ptr<Item>> items;
+        float rowHeight{0.0f};
+        std::string placeholderText{"..."};
+        ChildrenProvider childrenProvider;
+        std::vector<std::shared_ptr<Item>> items;
+        // Flattened visible items, in display order
+        mutable std::vector<Item*> visible;
+        // `visible` must be rebuilt, set when children are added to a shown & expanded item
+        mutable bool visibleDirty{false};
+        // Recycled row widgets, visible item `index` is displayed by rows[index % rows.size()]
+        std::vector<std::shared_ptr<Row>> rows;
         std::shared_ptr<Box> box;
         std::shared_ptr<VScrollBar> vScroll;
 
+        // Creates an item without updating the sizes, `parent` is nullptr for a root item
+        std::shared_ptr<Item>& createItem(Item* parent, const std::shared_ptr<Widget>& item);
+
+        // Index in `visible` of a shown item
+        size_t getVisibleIndex(const Item& item) const { return item.visibleIndex; }
+
+        // Updates the index of the visible items from `from` to the end, after a change of `visible`
+        void indexVisible(size_t from) const;
+
+        // End (exclusive) in `visible` of the visible descendants of the item at `index`
+        size_t getVisibleEnd(size_t index) const;
+
+        // Rebuilds `visible` from the items tree if needed
+        void updateVisible() const;
+
+        // Appends the visible descendants of an item to `result`
+        void appendVisibleChildren(const Item& item, std::vector<Item*>& result) const;
+
+        // Full height of a row, including the padding
+        float getRowFullHeight() const;
+
+        // Creates, binds & places the displayed rows
+        void updateRows();
+
+        // Removes the item widget from a row
+        void unbindRow(Row& row);
+
+        // Removes the item widgets from all the rows
+        void unbindRows();
+
         // Recompute total items height & update the scroll bar range.
         void computeSizes();
 
+        void eventLayout() override;
+
+        void onBoxMouseDown(const UIEventMouseButton& event);
+
         // Scroll handler bound to vScroll OnValueChange.
         void onVScrollChange(const UIEventValue& event);
     };
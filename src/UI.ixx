@@ -12,13 +12,19 @@ export import lysa.ui.button;
 export import lysa.ui.check_widget;
 export import lysa.ui.event;
 export import lysa.ui.frame;
+export import lysa.ui.gap_buffer;
 export import lysa.ui.image;
 export import lysa.ui.line;
 export import lysa.ui.list;
 export import lysa.ui.list_box;
+export import lysa.ui.mutation_queue;
 export import lysa.ui.panel;
 export import lysa.ui.popup;
+export import lysa.ui.prefix_sums;
 export import lysa.ui.progress_bar;
+export import lysa.ui.recording_renderer;
+export import lysa.ui.renderer;
+export import lysa.ui.rope;
 export import lysa.ui.uiresource;
 export import lysa.ui.scroll_bar;
 export import lysa.ui.scroll_box;
@@ -27,10 +33,13 @@ export import lysa.ui.style;
 export import lysa.ui.style_classic;
 export import lysa.ui.style_classic_resource;
 export import lysa.ui.text;
+export import lysa.ui.text_area;
 export import lysa.ui.text_edit;
+export import lysa.ui.text_measure_cache;
 export import lysa.ui.tree_view;
 export import lysa.ui.toggle_button;
 export import lysa.ui.value_select;
 export import lysa.ui.widget;
+export import lysa.ui.widget_snapshot;
 export import lysa.ui.window;
 export import lysa.ui.window_manager;
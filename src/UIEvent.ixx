@@ -7,6 +7,7 @@
 export module lysa.ui.event;
 
 export import lysa.event;
+import lysa.context;
 import lysa.input_event;
 import lysa.types;
 import lysa.ui.widget;
@@ -15,8 +16,80 @@ export namespace lysa::ui {
 
     /**
      * List of widget event signals.
+     *
+     * Each signal has a compile-time identifier bound to its payload type : use UIEvent::push()
+     * and UIEvent::subscribe() to get the payload type checked at compile time and the handlers
+     * called with a reference to the payload, without copy nor std::any_cast.
+     *
+     * The signals are stored by value in a queue per signal, reused from frame to frame, and
+     * dispatched by the UI thread at the start of the next frame, see dispatch(). The handlers
+     * are found with the signal Id & the target id, without name lookup.
      */
     struct UIEvent {
+        /**
+         * Compile-time identifiers of the signals
+         */
+        enum Id : uint8 {
+            ON_CREATE,
+            ON_DESTROY,
+            ON_KEY_DOWN,
+            ON_KEY_UP,
+            ON_MOUSE_DOWN,
+            ON_MOUSE_UP,
+            ON_MOUSE_MOVE,
+            ON_GOT_FOCUS,
+            ON_LOST_FOCUS,
+            ON_SHOW,
+            ON_HIDE,
+            ON_ENABLE,
+            ON_DISABLE,
+            ON_TEXT_CHANGE,
+            ON_TEXT_INPUT,
+            ON_CLICK,
+            ON_STATE_CHANGE,
+            ON_VALUE_CHANGE,
+            ON_RANGE_CHANGE,
+            ON_RESIZE,
+            ON_MOVE,
+            ON_INSERT_ITEM,
+            ON_REMOVE_ITEM,
+            ON_SELECT_ITEM,
+            ON_INSERT_ITEMS,
+            ON_REMOVE_ITEMS,
+            //! Number of signals
+            ID_COUNT
+        };
+
+        //! Names of the signals, indexed by Id
+        static constexpr std::array<std::string_view, ID_COUNT> NAMES{
+            "on_create",
+            "on_destroy",
+            "on_key_down",
+            "on_key_up",
+            "on_mouse_down",
+            "on_mouse_up",
+            "on_mouse_move",
+            "on_got_focus",
+            "on_lost_focus",
+            "on_show",
+            "on_hide",
+            "on_enable",
+            "on_disable",
+            "on_text_change",
+            "on_text_input",
+            "on_click",
+            "on_state_change",
+            "on_value_change",
+            "on_range_change",
+            "on_resize",
+            "on_move",
+            "on_insert_item",
+            "on_remove_item",
+            "on_select_item",
+            "on_insert_items",
+            "on_remove_items",
+        };
+
         static const std::string OnCreate;      //!< Called after widget creation (all widgets)
         static const std::string OnDestroy;     //!< Called before widget destruction (all widgets)
         static const std::string OnKeyDown;     //!< Called when the user presses a key & the widget has the keyboard focus (all widgets)
@@ -41,6 +114,81 @@ export namespace lysa::ui {
         static const std::string OnInsertItem;  //!< An item was inserted into a List
         static const std::string OnRemoveItem;  //!< An item was removed from a List
         static const std::string OnSelectItem;  //!< The selected item of a List changed
+        static const std::string OnInsertItems; //!< A range of items was inserted into a List
+        static const std::string OnRemoveItems; //!< A range of items was removed from a List
+
+        /**
+         * Returns the name of a signal, the event type used by the engine events queue.
+         */
+        static const event_type& getName(Id id);
+
+        /**
+         * Pushes a signal for a widget or a window.
+         * The payload must be of the type bound to the signal, see UIEventPayload.
+         * @param target Id of the widget or window.
+         * @param payload Parameters of the signal, moved into the event.
+         */
+        template <Id ID, typename T>
+        static void push(unique_id target, T&& payload);
+
+        /**
+         * Subscribes to a signal of a window.
+         * Use the Widget overload for the widgets : their lifecycle & input signals are only
+         * pushed when a handler is declared, see Widget::setSignalUndeclared().
+         * @param target Id of the window.
+         * @param handler Called with a const reference to the payload of each event.
+         * @return Id of the subscription, for unsubscribe().
+         */
+        template <Id ID, typename F>
+        static unique_id subscribe(unique_id target, F&& handler);
+
+        /**
+         * Subscribes to a signal of a widget, declaring the handler to the widget.
+         * @param target The widget.
+         * @param handler Called with a const reference to the payload of each event.
+         * @return Id of the subscription, for unsubscribe().
+         */
+        template <Id ID, typename F>
+        static unique_id subscribe(Widget& target, F&& handler);
+
+        /**
+         * Removes a subscription made with subscribe(Widget&, handler).
+         * @param target The widget.
+         * @param id The signal.
+         * @param subscription Id returned by subscribe().
+         */
+        static void unsubscribe(Widget& target, Id id, unique_id subscription);
+
+        /**
+         * Removes a subscription made with subscribe(unique_id, handler).
+         * @param id The signal.
+         * @param subscription Id returned by subscribe().
+         */
+        static void unsubscribe(Id id, unique_id subscription);
+
+        /**
+         * Copies the pushed signals to the engine events queue, for the handlers subscribed with
+         * `ctx().events.subscribe()` and the signal names (UIEvent::OnClick, ...) and for the Lua
+         * scripts. Enabled by default. Each copy is stored in a std::any, allocated on the heap
+         * for the payloads larger than a pointer : disable it when all the handlers are
+         * subscribed with subscribe().
+         */
+        static void setEngineEvents(const bool enabled) { engineEvents = enabled; }
+
+        /**
+         * Returns true if the pushed signals are copied to the engine events queue.
+         */
+        static bool isEngineEvents() { return engineEvents; }
+
+        /**
+         * Calls the handlers of the signals pushed since the last call, in their push order.
+         * The signals pushed by the handlers are dispatched by the next call.
+         * Called by the WindowManager at the start of each frame, from the UI thread.
+         */
+        static void dispatch();
+
+    private:
+        static inline bool engineEvents{true};
     };
 
     /**
@@ -102,7 +250,7 @@ export namespace lysa::ui {
      * Parameters for UIEvent::OnTextChange & UIEvent::OnTextInput
      */
     struct UIEventText : UIEvent {
-        const std::string text;
+        std::string text; //!< The text, empty for TextArea::OnTextChange
     };
 
     /**
@@ -113,29 +261,275 @@ export namespace lysa::ui {
         std::shared_ptr<Widget> item;   //!< Item widget, or nullptr
     };
 
-    const event_type UIEvent::OnCreate{"on_create"};
-    const event_type UIEvent::OnDestroy{"on_destroy"};
-    const event_type UIEvent::OnKeyDown{"on_key_down"};
-    const event_type UIEvent::OnKeyUp{"on_key_up"};
-    const event_type UIEvent::OnMouseDown{"on_mouse_down"};
-    const event_type UIEvent::OnMouseUp{"on_mouse_up"};
-    const event_type UIEvent::OnMouseMove{"on_mouse_move"};
-    const event_type UIEvent::OnGotFocus{"on_got_focus"};
-    const event_type UIEvent::OnLostFocus{"on_lost_focus"};
-    const event_type UIEvent::OnShow{"on_show"};
-    const event_type UIEvent::OnHide{"on_hide"};
-    const event_type UIEvent::OnEnable{"on_enable"};
-    const event_type UIEvent::OnDisable{"on_disable"};
-    const event_type UIEvent::OnTextChange{"on_text_change"};
-    const event_type UIEvent::OnTextInput{"on_text_input"};
-    const event_type UIEvent::OnClick{"on_click"};
-    const event_type UIEvent::OnStateChange{"on_state_change"};
-    const event_type UIEvent::OnResize{"on_resize"};
-    const event_type UIEvent::OnMove{"on_move"};
-    const event_type UIEvent::OnValueChange{"on_value_change"};
-    //const event_type UIEvent::OnValueUserChange{"on_value_use_change"};
-    const event_type UIEvent::OnRangeChange{"on_range_change"};
-    const event_type UIEvent::OnInsertItem{"on_insert_item"};
-    const event_type UIEvent::OnRemoveItem{"on_remove_item"};
-    const event_type UIEvent::OnSelectItem{"on_select_item"};
+    /**
+    * Parameters for UIEvent::OnInsertItems & UIEvent::OnRemoveItems.
+    */
+    struct UIEventItems : UIEvent {
+        int32 index;                    //!< Index (0-based) of the first item of the range
+        int32 count;                    //!< Number of items in the range
+    };
+
+    // Names are copied into each pushed event : they must fit in the small string buffer
+    static_assert(std::ranges::all_of(UIEvent::NAMES, [](const auto name) { return name.size() <= 15; }));
+
+    const event_type UIEvent::OnCreate{NAMES[ON_CREATE]};
+    const event_type UIEvent::OnDestroy{NAMES[ON_DESTROY]};
+    const event_type UIEvent::OnKeyDown{NAMES[ON_KEY_DOWN]};
+    const event_type UIEvent::OnKeyUp{NAMES[ON_KEY_UP]};
+    const event_type UIEvent::OnMouseDown{NAMES[ON_MOUSE_DOWN]};
+    const event_type UIEvent::OnMouseUp{NAMES[ON_MOUSE_UP]};
+    const event_type UIEvent::OnMouseMove{NAMES[ON_MOUSE_MOVE]};
+    const event_type UIEvent::OnGotFocus{NAMES[ON_GOT_FOCUS]};
+    const event_type UIEvent::OnLostFocus{NAMES[ON_LOST_FOCUS]};
+    const event_type UIEvent::OnShow{NAMES[ON_SHOW]};
+    const event_type UIEvent::OnHide{NAMES[ON_HIDE]};
+    const event_type UIEvent::OnEnable{NAMES[ON_ENABLE]};
+    const event_type UIEvent::OnDisable{NAMES[ON_DISABLE]};
+    const event_type UIEvent::OnTextChange{NAMES[ON_TEXT_CHANGE]};
+    const event_type UIEvent::OnTextInput{NAMES[ON_TEXT_INPUT]};
+    const event_type UIEvent::OnClick{NAMES[ON_CLICK]};
+    const event_type UIEvent::OnStateChange{NAMES[ON_STATE_CHANGE]};
+    const event_type UIEvent::OnValueChange{NAMES[ON_VALUE_CHANGE]};
+    const event_type UIEvent::OnRangeChange{NAMES[ON_RANGE_CHANGE]};
+    const event_type UIEvent::OnResize{NAMES[ON_RESIZE]};
+    const event_type UIEvent::OnMove{NAMES[ON_MOVE]};
+    const event_type UIEvent::OnInsertItem{NAMES[ON_INSERT_ITEM]};
+    const event_type UIEvent::OnRemoveItem{NAMES[ON_REMOVE_ITEM]};
+    const event_type UIEvent::OnSelectItem{NAMES[ON_SELECT_ITEM]};
+    const event_type UIEvent::OnInsertItems{NAMES[ON_INSERT_ITEMS]};
+    const event_type UIEvent::OnRemoveItems{NAMES[ON_REMOVE_ITEMS]};
+
+    const event_type& UIEvent::getName(const Id id) {
+        static const std::array<const event_type*, ID_COUNT> names{
+            &OnCreate,
+            &OnDestroy,
+            &OnKeyDown,
+            &OnKeyUp,
+            &OnMouseDown,
+            &OnMouseUp,
+            &OnMouseMove,
+            &OnGotFocus,
+            &OnLostFocus,
+            &OnShow,
+            &OnHide,
+            &OnEnable,
+            &OnDisable,
+            &OnTextChange,
+            &OnTextInput,
+            &OnClick,
+            &OnStateChange,
+            &OnValueChange,
+            &OnRangeChange,
+            &OnResize,
+            &OnMove,
+            &OnInsertItem,
+            &OnRemoveItem,
+            &OnSelectItem,
+            &OnInsertItems,
+            &OnRemoveItems,
+        };
+        return *names[id];
+    }
+
+    /**
+     * Payload type bound to a signal.
+     */
+    template <UIEvent::Id ID>
+    consteval auto getPayloadType() {
+        if constexpr (ID == UIEvent::ON_KEY_DOWN || ID == UIEvent::ON_KEY_UP) {
+            return std::type_identity<UIEventKeyb>{};
+        } else if constexpr (ID == UIEvent::ON_MOUSE_DOWN || ID == UIEvent::ON_MOUSE_UP) {
+            return std::type_identity<UIEventMouseButton>{};
+        } else if constexpr (ID == UIEvent::ON_MOUSE_MOVE) {
+            return std::type_identity<UIEventMouseMove>{};
+        } else if constexpr (ID == UIEvent::ON_TEXT_CHANGE || ID == UIEvent::ON_TEXT_INPUT) {
+            return std::type_identity<UIEventText>{};
+        } else if constexpr (ID == UIEvent::ON_CLICK) {
+            return std::type_identity<UIEventClick>{};
+        } else if constexpr (ID == UIEvent::ON_STATE_CHANGE) {
+            return std::type_identity<UIEventState>{};
+        } else if constexpr (ID == UIEvent::ON_VALUE_CHANGE) {
+            return std::type_identity<UIEventValue>{};
+        } else if constexpr (ID == UIEvent::ON_RANGE_CHANGE) {
+            return std::type_identity<UIEventRange>{};
+        } else if constexpr (ID == UIEvent::ON_INSERT_ITEM || ID == UIEvent::ON_REMOVE_ITEM || ID == UIEvent::ON_SELECT_ITEM) {
+            return std::type_identity<UIEventItem>{};
+        } else if constexpr (ID == UIEvent::ON_INSERT_ITEMS || ID == UIEvent::ON_REMOVE_ITEMS) {
+            return std::type_identity<UIEventItems>{};
+        } else {
+            return std::type_identity<UIEvent>{};
+        }
+    }
+
+    template <UIEvent::Id ID>
+    using UIEventPayload = typename decltype(getPayloadType<ID>())::type;
+
+}
+
+namespace lysa::ui {
+
+    // Queue & handlers of a signal, the payloads are stored by value without type erasure.
+    // Only used by the UI thread.
+    template <UIEvent::Id ID>
+    class UIEventChannel {
+    public:
+        using Payload = UIEventPayload<ID>;
+        using Handler = std::function<void(const Payload&)>;
+
+        // Returns the index of the signal in the queue
+        static uint32 push(const unique_id target, Payload&& payload) {
+            pending.push_back({target, std::move(payload)});
+            return static_cast<uint32>(pending.size() - 1);
+        }
+
+        static void subscribe(const unique_id subscription, const unique_id target, Handler&& handler) {
+            handlers[target].push_back({subscription, std::make_shared<Handler>(std::move(handler))});
+        }
+
+        static void unsubscribe(const unique_id subscription) {
+            for (auto& targetHandlers : handlers | std::views::values) {
+                for (auto& h : targetHandlers) {
+                    if (h.subscription == subscription) {
+                        // Erased after the dispatch, the handlers can unsubscribe themselves
+                        h.handler.reset();
+                        removed = true;
+                        return;
+                    }
+                }
+            }
+        }
+
+        // Starts a dispatch : the signals pushed from now on are kept for the next one
+        static void begin() {
+            std::swap(pending, dispatched);
+        }
+
+        static void dispatch(const uint32 index) {
+            const auto& signal = dispatched[index];
+            const auto it = handlers.find(signal.target);
+            if (it == handlers.end()) { return; }
+            // The vector is not moved by new subscriptions to other targets, only reallocated by
+            // new subscriptions to the same target : by index, with a reference on the handler
+            const auto& targetHandlers = it->second;
+            for (size_t i = 0; i < targetHandlers.size(); i++) {
+                if (const auto handler = targetHandlers[i].handler) {
+                    (*handler)(signal.payload);
+                }
+            }
+        }
+
+        // Ends a dispatch, keeping the capacity of the queue for the next frames
+        static void end() {
+            dispatched.clear();
+            if (!removed) { return; }
+            for (auto it = handlers.begin(); it != handlers.end();) {
+                std::erase_if(it->second, [](const Subscription& h) { return h.handler == nullptr; });
+                it = it->second.empty() ? handlers.erase(it) : std::next(it);
+            }
+            removed = false;
+        }
+
+    private:
+        struct Signal {
+            unique_id target;
+            Payload payload;
+        };
+
+        struct Subscription {
+            unique_id subscription;
+            std::shared_ptr<Handler> handler;
+        };
+
+        static inline std::vector<Signal> pending;
+        static inline std::vector<Signal> dispatched;
+        static inline std::unordered_map<unique_id, std::vector<Subscription>> handlers;
+        static inline bool removed{false};
+    };
+
+    // Operations of the channel of a signal
+    struct UIEventChannelOps {
+        void (*begin)();
+        void (*dispatch)(uint32);
+        void (*end)();
+        void (*unsubscribe)(unique_id);
+    };
+
+    template <size_t... IDS>
+    constexpr std::array<UIEventChannelOps, UIEvent::ID_COUNT> makeUIEventChannels(std::index_sequence<IDS...>) {
+        return {UIEventChannelOps{
+            &UIEventChannel<static_cast<UIEvent::Id>(IDS)>::begin,
+            &UIEventChannel<static_cast<UIEvent::Id>(IDS)>::dispatch,
+            &UIEventChannel<static_cast<UIEvent::Id>(IDS)>::end,
+            &UIEventChannel<static_cast<UIEvent::Id>(IDS)>::unsubscribe,
+        }...};
+    }
+
+    // Order of the signals pushed in all the channels, only used by the UI thread
+    struct UIEventQueue {
+        struct Pending {
+            UIEvent::Id id;
+            uint32 index;
+        };
+
+        static inline std::vector<Pending> pending;
+        static inline std::vector<Pending> dispatched;
+        static inline unique_id nextSubscription{1};
+
+        // Channels indexed by signal Id
+        static constexpr auto channels{makeUIEventChannels(std::make_index_sequence<UIEvent::ID_COUNT>{})};
+    };
+
+}
+
+export namespace lysa::ui {
+
+    void UIEvent::unsubscribe(Widget& target, const Id id, const unique_id subscription) {
+        target.removeSubscription(id);
+        unsubscribe(id, subscription);
+    }
+
+    void UIEvent::unsubscribe(const Id id, const unique_id subscription) {
+        UIEventQueue::channels[id].unsubscribe(subscription);
+    }
+
+    void UIEvent::dispatch() {
+        std::swap(UIEventQueue::pending, UIEventQueue::dispatched);
+        for (const auto& channel : UIEventQueue::channels) {
+            channel.begin();
+        }
+        for (const auto& signal : UIEventQueue::dispatched) {
+            UIEventQueue::channels[signal.id].dispatch(signal.index);
+        }
+        UIEventQueue::dispatched.clear();
+        for (const auto& channel : UIEventQueue::channels) {
+            channel.end();
+        }
+    }
+
+    template <UIEvent::Id ID, typename T>
+    void UIEvent::push(const unique_id target, T&& payload) {
+        using Payload = UIEventPayload<ID>;
+        static_assert(std::is_same_v<std::remove_cvref_t<T>, Payload>, "UIEvent::push: wrong payload type for this signal");
+        static_assert(std::is_nothrow_move_constructible_v<Payload>);
+        if (engineEvents) {
+            ctx().events.push({getName(ID), Payload{payload}, target});
+        }
+        // Moved into the reused queue of the signal : no allocation once the queue has grown
+        UIEventQueue::pending.push_back({ID, UIEventChannel<ID>::push(target, Payload{std::forward<T>(payload)})});
+    }
+
+    template <UIEvent::Id ID, typename F>
+    unique_id UIEvent::subscribe(const unique_id target, F&& handler) {
+        using Payload = UIEventPayload<ID>;
+        static_assert(std::is_invocable_v<F&, const Payload&>, "UIEvent::subscribe: the handler must accept the payload of this signal");
+        const auto subscription = UIEventQueue::nextSubscription++;
+        UIEventChannel<ID>::subscribe(subscription, target, typename UIEventChannel<ID>::Handler{std::forward<F>(handler)});
+        return subscription;
+    }
+
+    template <UIEvent::Id ID, typename F>
+    unique_id UIEvent::subscribe(Widget& target, F&& handler) {
+        target.addSubscription(ID);
+        return subscribe<ID>(target.id, std::forward<F>(handler));
+    }
 }
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.renderer;
+
+#ifdef LYSA_UI_HEADLESS
+export import lysa.ui.recording_renderer;
+#else
+export import lysa.renderers.vector_2d;
+#endif
+
+export namespace lysa::ui {
+
+    /**
+     * 2D renderer used to draw the UI : the engine Vector2DRenderer,
+     * or the in-memory RecordingRenderer when building with `LYSA_UI_HEADLESS`.
+     */
+#ifdef LYSA_UI_HEADLESS
+    using UIRenderer = RecordingRenderer;
+#else
+    using UIRenderer = Vector2DRenderer;
+#endif
+
+}
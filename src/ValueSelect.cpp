@@ -31,10 +31,10 @@ namespace lysa::ui {
         if (value < min) {
             setValue(min);
         }
-        resizeChildren();
+        invalidateLayout();
         eventRangeChange();
-        refresh();
-        ctx().events.push({UIEvent::OnRangeChange, UIEventRange{.min = min, .max = max, .value = value}, id});
+        invalidatePaint();
+        UIEvent::push<UIEvent::ON_RANGE_CHANGE>(id, UIEventRange{.min = min, .max = max, .value = value});
     }
 
     void ValueSelect::setMax(const float max) {
@@ -44,9 +44,9 @@ namespace lysa::ui {
         if (value > max) {
             setValue(max);
         }
-        resizeChildren();
+        invalidateLayout();
         eventRangeChange();
-        ctx().events.push({UIEvent::OnRangeChange, UIEventRange{.min = min, .max = max, .value = value}, id});
+        UIEvent::push<UIEvent::ON_RANGE_CHANGE>(id, UIEventRange{.min = min, .max = max, .value = value});
     }
 
     void ValueSelect::setValue(const float value) {
@@ -60,11 +60,8 @@ namespace lysa::ui {
             this->value = max;
         }
         eventRangeChange();
-        refresh();
-        if (parent) {
-            parent->refresh();
-        }
-        ctx().events.push({UIEvent::OnValueChange, UIEventValue{.value = this->value, .previous = prev}, id});
+        invalidatePaint();
+        UIEvent::push<UIEvent::ON_VALUE_CHANGE>(id, UIEventValue{.value = this->value, .previous = prev});
     }
 
     void ValueSelect::setStep(const float step) {
@@ -72,20 +69,19 @@ namespace lysa::ui {
         assert([&] { return step != 0;}, "ValueSelect: can't use a step of 0");
         this->step = step;
         eventRangeChange();
-        refresh();
+        invalidatePaint();
     }
 
-    void ValueSelect::eventResize() {
-        Widget::eventResize();
+    void ValueSelect::eventLayout() {
         eventRangeChange();
     }
 
     void ValueSelect::eventRangeChange() {
-        ctx().events.push({UIEvent::OnRangeChange, UIEventRange{.min = min, .max = max, .value = value}, id});
+        UIEvent::push<UIEvent::ON_RANGE_CHANGE>(id, UIEventRange{.min = min, .max = max, .value = value});
     }
 
     void ValueSelect::eventValueChange(const float prev) {
-        ctx().events.push({UIEvent::OnValueChange, UIEventRange{.min = min, .max = max, .value = value}, id});
+        UIEvent::push<UIEvent::ON_VALUE_CHANGE>(id, UIEventValue{.value = value, .previous = prev});
     }
 
 }
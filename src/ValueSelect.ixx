@@ -78,7 +78,7 @@ export namespace lysa::ui {
         float value;
         float step;
 
-        void eventResize() override;
+        void eventLayout() override;
 
         virtual void eventRangeChange();
 
@@ -8,38 +8,196 @@ module lysa.ui.widget;
 
 import lysa.log;
 import lysa.rect;
-import lysa.renderers.vector_2d;
+import lysa.ui.renderer;
 import lysa.resources.font;
 import lysa.ui.event;
 import lysa.ui.uiresource;
 import lysa.ui.style;
 import lysa.ui.window;
+import lysa.ui.window_manager;
 
 namespace lysa::ui {
 
     Widget::Widget( const Type type) : type{type} {}
 
-    void Widget::_draw(Vector2DRenderer &renderer) {
+    void Widget::_draw(UIRenderer &renderer, const float2& translate, const Rect& clip, const bool force) {
         if (!isVisible()) {
+            if (force) {
+                // Recorded with the new translation when shown again
+                dirty |= DIRTY_PAINT | DIRTY_OFFSET;
+            }
             return;
         }
-        if (dirty) {
-            dirty = false;
+        const auto *s = static_cast<Style *>(style);
+        // The children are drawn translated by the children offset, their layout is unchanged
+        const float2 childrenTranslate{translate.x - childrenOffsetX, translate.y - childrenOffsetY};
+        const auto childrenClip = getChildrenClip(clip);
+        if (drawSessionBefore == INVALID_ID) {
+            // First recording : the sessions must be created in the drawing order
+            renderer.setTranslate(translate);
             drawSessionBefore = renderer.beginDraw(drawSessionBefore);
-            const auto *s = static_cast<Style *>(style);
             s->draw(*this, *resource, renderer, true);
             renderer.endDraw();
             for (const auto &child : children) {
-                child->_draw(renderer);
+                child->culled = child->isClipped(childrenClip);
+                if (child->culled) {
+                    // Recorded when entering the clip
+                    child->reserveDrawSessions(renderer);
+                } else {
+                    child->_draw(renderer, childrenTranslate, childrenClip);
+                }
             }
+            renderer.setTranslate(translate);
             drawSessionAfter = renderer.beginDraw(drawSessionAfter);
             s->draw(*this, *resource, renderer, false);
             renderer.endDraw();
         } else {
+            if (force || (dirty & (DIRTY_PAINT | DIRTY_LAYOUT))) {
+                renderer.setTranslate(translate);
+                renderer.beginDraw(drawSessionBefore);
+                s->draw(*this, *resource, renderer, true);
+                renderer.endDraw();
+                renderer.beginDraw(drawSessionAfter);
+                s->draw(*this, *resource, renderer, false);
+                renderer.endDraw();
+            }
+            // A new layout changes the clip, a new children offset moves all the descendants sessions
+            if (force || (dirty & (DIRTY_SUBTREE | DIRTY_OFFSET | DIRTY_LAYOUT))) {
+                const auto all = force || (dirty & DIRTY_OFFSET);
+                for (const auto &child : children) {
+                    const auto culledChild = child->isClipped(childrenClip);
+                    if (culledChild != child->culled) {
+                        child->culled = culledChild;
+                        if (!culledChild) {
+                            // Not recorded while outside of the clip
+                            child->_draw(renderer, childrenTranslate, childrenClip, true);
+                        }
+                        child->changeDrawVisibility(false);
+                    } else if (!culledChild && (all || (child->dirty != DIRTY_NONE))) {
+                        child->_draw(renderer, childrenTranslate, childrenClip, all);
+                    }
+                }
+            }
+        }
+        // The layout flags raised during the layout pass are consumed by the next _layout()
+        dirty &= DIRTY_LAYOUT | DIRTY_SUBTREE_LAYOUT;
+    }
+
+    void Widget::reserveDrawSessions(UIRenderer &renderer) {
+        if (!isVisible() || (drawSessionBefore != INVALID_ID)) {
+            return;
+        }
+        drawSessionBefore = renderer.beginDraw(drawSessionBefore);
+        renderer.endDraw();
+        for (const auto &child : children) {
+            child->reserveDrawSessions(renderer);
+        }
+        drawSessionAfter = renderer.beginDraw(drawSessionAfter);
+        renderer.endDraw();
+    }
+
+    Rect Widget::getChildrenClip(const Rect& clip) const {
+        auto result = clip;
+        if (clipChildren) {
+            const auto left   = std::max(clip.x, rect.x + hborder);
+            const auto top    = std::max(clip.y, rect.y + vborder);
+            const auto right  = std::min(clip.x + clip.width, rect.x + rect.width - hborder);
+            const auto bottom = std::min(clip.y + clip.height, rect.y + rect.height - vborder);
+            result.x      = left;
+            result.y      = top;
+            result.width  = std::max(0.0f, right - left);
+            result.height = std::max(0.0f, bottom - top);
+        }
+        result.x += childrenOffsetX;
+        result.y += childrenOffsetY;
+        return result;
+    }
+
+    bool Widget::isClipped(const Rect& clip) const {
+        return (childrenRect.x >= (clip.x + clip.width)) ||
+               (childrenRect.y >= (clip.y + clip.height)) ||
+               ((childrenRect.x + childrenRect.width) <= clip.x) ||
+               ((childrenRect.y + childrenRect.height) <= clip.y);
+    }
+
+    bool Widget::isInChildrenClip(const float x, const float y) const {
+        return !clipChildren || (
+            (x >= (rect.x + hborder)) && (x < (rect.x + rect.width - hborder)) &&
+            (y >= (rect.y + vborder)) && (y < (rect.y + rect.height - vborder)));
+    }
+
+    void Widget::_layout() {
+        if (freezed || !effectiveVisible) {
+            return;
+        }
+        auto changed = false;
+        if (dirty & DIRTY_LAYOUT) {
+            resizeChildren();
+            dirty = (dirty & ~DIRTY_LAYOUT) | DIRTY_PAINT;
+            changed = true;
+        }
+        if (dirty & DIRTY_SUBTREE_LAYOUT) {
+            dirty &= ~DIRTY_SUBTREE_LAYOUT;
             for (const auto &child : children) {
-                child->_draw(renderer);
+                // Hidden subtrees keep their flags and are laid out when shown again
+                if (!child->effectiveVisible) { continue; }
+                if (child->dirty & (DIRTY_LAYOUT | DIRTY_SUBTREE_LAYOUT)) {
+                    child->_layout();
+                    changed = true;
+                }
+                // Children invalidated during this pass (or freezed) are laid out by the next pass
+                if (child->dirty & (DIRTY_LAYOUT | DIRTY_SUBTREE_LAYOUT)) {
+                    dirty |= DIRTY_SUBTREE_LAYOUT;
+                }
             }
         }
+        if (changed) {
+            eventLayout();
+            updateChildrenRect();
+        }
+    }
+
+    bool Widget::updateChildrenRect() {
+        // Children are laid out before their parent : their own bounds are up to date
+        auto left   = std::numeric_limits<float>::max();
+        auto top    = std::numeric_limits<float>::max();
+        auto right  = std::numeric_limits<float>::lowest();
+        auto bottom = std::numeric_limits<float>::lowest();
+        for (const auto &child : children) {
+            if (!child->effectiveVisible) { continue; }
+            const auto &r = child->childrenRect;
+            left   = std::min(left, r.x);
+            top    = std::min(top, r.y);
+            right  = std::max(right, r.x + r.width);
+            bottom = std::max(bottom, r.y + r.height);
+        }
+        contentRect.x      = left;
+        contentRect.y      = top;
+        contentRect.width  = right - left;
+        contentRect.height = bottom - top;
+        return offsetChildrenRect();
+    }
+
+    bool Widget::offsetChildrenRect() {
+        auto left   = rect.x;
+        auto top    = rect.y;
+        auto right  = rect.x + rect.width;
+        auto bottom = rect.y + rect.height;
+        // Clipped children never extend the bounds
+        if (!clipChildren && (contentRect.width >= 0.0f)) {
+            left   = std::min(left, contentRect.x - childrenOffsetX);
+            top    = std::min(top, contentRect.y - childrenOffsetY);
+            right  = std::max(right, contentRect.x + contentRect.width - childrenOffsetX);
+            bottom = std::max(bottom, contentRect.y + contentRect.height - childrenOffsetY);
+        }
+        const auto changed =
+            (childrenRect.x != left) || (childrenRect.y != top) ||
+            (childrenRect.width != right - left) || (childrenRect.height != bottom - top);
+        childrenRect.x      = left;
+        childrenRect.y      = top;
+        childrenRect.width  = right - left;
+        childrenRect.height = bottom - top;
+        return changed;
     }
 
     void Widget::clearDrawSessions() const {
@@ -53,32 +211,64 @@ namespace lysa::ui {
         }
     }
 
+    void Widget::_resetDrawSessions() {
+        if ((window != nullptr) && (drawSessionBefore != INVALID_ID)) {
+            auto& renderer = static_cast<Window*>(window)->getRenderer();
+            renderer.clearSession(drawSessionBefore);
+            renderer.clearSession(drawSessionAfter);
+        }
+        drawSessionBefore = INVALID_ID;
+        drawSessionAfter = INVALID_ID;
+        dirty |= DIRTY_PAINT;
+        for (const auto& child : children) {
+            child->_resetDrawSessions();
+        }
+    }
+
     bool Widget::isVisible() const {
-        auto p = this;
-        do {
-            if (!p->visible) {
-                return false;
-            }
-        } while ((p = p->parent) != nullptr);
-        return (window && static_cast<Window*>(window)->isVisible());
+        return effectiveVisible && window && static_cast<Window*>(window)->isVisible();
     }
 
-    void Widget::changeDrawVisibility() const {
+    void Widget::changeDrawVisibility(const bool culledParent) {
+        effectiveVisible = visible && ((parent == nullptr) || parent->effectiveVisible);
+        const auto hidden = culledParent || culled;
         if (window) {
             auto& renderer = static_cast<Window*>(window)->getRenderer();
-            const auto v = isVisible();
+            const auto v = isVisible() && !hidden;
             renderer.setVisible(drawSessionBefore, v);
             renderer.setVisible(drawSessionAfter, v);
-            for (const auto& child : children) {
-                child->changeDrawVisibility();
-            }
+        }
+        for (const auto& child : children) {
+            child->changeDrawVisibility(hidden);
         }
     }
 
+    void Widget::updateEffectiveVisible() {
+        effectiveVisible = visible && ((parent == nullptr) || parent->effectiveVisible);
+        for (const auto& child : children) {
+            child->updateEffectiveVisible();
+        }
+    }
+
+    bool Widget::isCulled() const {
+        for (auto w = this; w != nullptr; w = w->parent) {
+            if (w->culled) { return true; }
+        }
+        return false;
+    }
+
     void Widget::setVisible(const bool show) {
         if (visible == show) { return; }
         visible = show;
-        changeDrawVisibility();
+        changeDrawVisibility((parent != nullptr) && parent->isCulled());
+        // The parent bounds depend on the visible children
+        if (parent) { parent->invalidateLayout(); }
+        if (visible && (dirty & (DIRTY_LAYOUT | DIRTY_SUBTREE_LAYOUT))) {
+            invalidateParents(DIRTY_SUBTREE | DIRTY_SUBTREE_LAYOUT);
+        } else if (visible && (dirty != DIRTY_NONE)) {
+            // Sessions left outdated while hidden, by a children offset change for example
+            invalidateParents(DIRTY_SUBTREE);
+        }
         if (visible) {
             eventShow();
         } else {
@@ -102,15 +292,17 @@ namespace lysa::ui {
     }
 
     void Widget::setSize(const float width, const float height) {
-        if (parent) { parent->refresh(); }
+        if ((width == rect.width) && (height == rect.height)) { return; }
+        const auto previous = rect;
         rect.width  = width;
         rect.height = height;
+        if (parent) { parent->eventChildRectChange(*this, previous); }
         eventResize();
     }
 
     void Widget::setResource(std::shared_ptr<UIResource> res) {
         resource = std::move(res);
-        refresh();
+        invalidatePaint();
     }
 
     std::shared_ptr<Widget> Widget::setNextFocus() {
@@ -159,13 +351,16 @@ namespace lysa::ui {
         if (focused != F) {
             focused = F;
             if (F) {
-                if (!freezed) {
-                    refresh();
-                }
+                invalidatePaint();
                 static_cast<Window*>(window)->setFocusedWidget(shared_from_this());
-                ctx().events.push({UIEvent::OnGotFocus, {}, id});
+                if (isSignaled(UIEvent::ON_GOT_FOCUS)) {
+                    UIEvent::push<UIEvent::ON_GOT_FOCUS>(id, UIEvent{});
+                }
             } else {
-                ctx().events.push({UIEvent::OnLostFocus, {}, id});
+                invalidatePaint();
+                if (isSignaled(UIEvent::ON_LOST_FOCUS)) {
+                    UIEvent::push<UIEvent::ON_LOST_FOCUS>(id, UIEvent{});
+                }
                 /*shared_ptr<Widget>p = parent;
                 while (p && (!p->DrawBackground())) p = p->parent;
                 if (p) { p->Refresh(rect); }*/
@@ -186,6 +381,16 @@ namespace lysa::ui {
         return (font ? font : static_cast<Window*>(window)->getFont());
     }
 
+    void Widget::measureText(const std::string& text, float& width, float& height) const {
+        const auto& font = getFont();
+        const auto scale = getFontScale();
+        if (auto* windowManager = static_cast<WindowManager*>(static_cast<Window*>(window)->_getWindowManager())) {
+            windowManager->getTextMeasureCache().getSize(font, scale, text, width, height);
+        } else {
+            font->getSize(text, scale, width, height);
+        }
+    }
+
     void Widget::_init(Widget &child, const Alignment alignment, const std::string &res, const bool overlap) {
         child.alignment = alignment;
         child.overlap   = overlap;
@@ -193,13 +398,35 @@ namespace lysa::ui {
         if (child.fontScale <= 0.0f) { child.fontScale = fontScale; }
         child.window = window;
         child.style  = style;
+        // A recycled child (re-added after a remove()) already uses the arena
+        if ((arena != nullptr) && (child.arena != arena)) { child._setArena(arena); }
         child.parent = this;
+        // A re-added subtree can have been hidden with its previous parent
+        child.updateEffectiveVisible();
         static_cast<Style *>(style)->addResource(child, res);
         child.eventCreate();
         child.freezed = false;
-        if (static_cast<Window *>(window)->isVisible() && (resource != nullptr)) {
-            resizeChildren();
-        }
+        child.invalidateLayout();
+        invalidateLayout();
+    }
+
+    bool Widget::_reattach(const std::shared_ptr<Widget>& child, const Alignment alignment) {
+        if (!allowChildren || (child->window != window) || (child->parent != nullptr)) { return false; }
+        children.push_back(child);
+        child->alignment = alignment;
+        child->parent = this;
+        child->updateEffectiveVisible();
+        child->invalidateLayout();
+        invalidateLayout();
+        return true;
+    }
+
+    void Widget::_setArena(const std::shared_ptr<std::pmr::memory_resource>& arena) {
+        assert([&]{ return children.empty(); }, "The arena must be set before adding children");
+        this->arena = arena;
+        // The allocator of a list can't be changed, rebuild the (empty) children list on the arena
+        std::destroy_at(&children);
+        std::construct_at(&children, arena != nullptr ? arena.get() : std::pmr::get_default_resource());
     }
 
     void Widget::remove(const std::shared_ptr<Widget>& child) {
@@ -210,9 +437,27 @@ namespace lysa::ui {
             //     W->remove(child);
             // }
             children.remove(child);
-            resizeChildren();
+            invalidateLayout();
         }
-        refresh();
+        invalidatePaint();
+    }
+
+    void Widget::removeChildren(const std::span<const std::shared_ptr<Widget>> removed) {
+        if (removed.empty()) { return; }
+        std::unordered_set<const Widget*> removedSet;
+        removedSet.reserve(removed.size());
+        for (const auto& child : removed) {
+            removedSet.insert(child.get());
+        }
+        const auto count = std::erase_if(children, [&](const std::shared_ptr<Widget>& child) {
+            if (!removedSet.contains(child.get())) { return false; }
+            child->parent = nullptr;
+            return true;
+        });
+        if (count > 0) {
+            invalidateLayout();
+        }
+        invalidatePaint();
     }
 
     void Widget::removeAll() {
@@ -221,31 +466,52 @@ namespace lysa::ui {
             child->removeAll();
         }
         children.clear();
-        refresh();
+        invalidatePaint();
+    }
+
+    void Widget::addSubscription(const uint8 event) {
+        assert([&]{ return event < UIEvent::ID_COUNT; }, "Widget: invalid UIEvent::Id");
+        subscriptions.push_back(event);
+        subscribedEvents |= 1u << event;
+    }
+
+    void Widget::removeSubscription(const uint8 event) {
+        const auto it = std::ranges::find(subscriptions, event);
+        if (it == subscriptions.end()) { return; }
+        subscriptions.erase(it);
+        if (!std::ranges::contains(subscriptions, event)) {
+            subscribedEvents &= ~(1u << event);
+        }
     }
 
     void Widget::eventCreate() {
-        ctx().events.push({UIEvent::OnCreate,  UIEvent{}, id});
+        if (isSignaled(UIEvent::ON_CREATE)) {
+            UIEvent::push<UIEvent::ON_CREATE>(id, UIEvent{});
+        }
     }
 
-    void Widget::eventDestroy(Vector2DRenderer& renderer) {
+    void Widget::eventDestroy(UIRenderer& renderer) {
         renderer.clearSession(drawSessionBefore);
         renderer.clearSession(drawSessionAfter);
         for (const auto &child : children) {
             child->eventDestroy(renderer);
         }
-        ctx().events.push({UIEvent::OnDestroy,  UIEvent{}, id});
+        if (isSignaled(UIEvent::ON_DESTROY)) {
+            UIEvent::push<UIEvent::ON_DESTROY>(id, UIEvent{});
+        }
         children.clear();
     }
 
     void Widget::eventShow() {
         if (visible) {
-            ctx().events.push({UIEvent::OnShow,  UIEvent{}, id});
+            if (isSignaled(UIEvent::ON_SHOW)) {
+                UIEvent::push<UIEvent::ON_SHOW>(id, UIEvent{});
+            }
             for (const auto &child : children) {
                 child->eventShow();
             }
             if (parent) {
-                refresh();
+                invalidatePaint();
             }
         }
     }
@@ -256,49 +522,57 @@ namespace lysa::ui {
                 child->eventHide();
             }
             if (parent) {
-                parent->refresh();
+                parent->invalidatePaint();
+            }
+            if (isSignaled(UIEvent::ON_HIDE)) {
+                UIEvent::push<UIEvent::ON_HIDE>(id, UIEvent{});
             }
-            ctx().events.push({UIEvent::OnHide,  UIEvent{}, id});
         }
     }
 
     void Widget::eventEnable() {
-        ctx().events.push({UIEvent::OnEnable,  UIEvent{}, id});
+        if (isSignaled(UIEvent::ON_ENABLE)) {
+            UIEvent::push<UIEvent::ON_ENABLE>(id, UIEvent{});
+        }
         for (const auto &child : children) {
             child->setEnabled();
         }
-        refresh();
+        invalidatePaint();
     }
 
     void Widget::eventDisable() {
         for (const auto &child : children) {
             child->setEnabled(false);
         }
-        ctx().events.push({UIEvent::OnDisable,  UIEvent{}, id});
-        refresh();
+        if (isSignaled(UIEvent::ON_DISABLE)) {
+            UIEvent::push<UIEvent::ON_DISABLE>(id, UIEvent{});
+        }
+        invalidatePaint();
     }
 
     void Widget::eventMove(const float x, const float y) {
         const float diffX = rect.x - x;
         const float diffY = rect.y - y;
+        const auto previous = rect;
         rect.x = x;
         rect.y = y;
+        if (parent) { parent->eventChildRectChange(*this, previous); }
+        // Aligned children are placed by the layout pass, only move the free ones
         for (const auto &w : children) {
-            w->setPos(w->rect.x - diffX, w->rect.y - diffY);
-        }
-        if (parent) {
-            parent->refresh();
+            if (w->alignment == Alignment::NONE) {
+                w->setPos(w->rect.x - diffX, w->rect.y - diffY);
+            }
         }
-        refresh();
+        setDirty(DIRTY_LAYOUT);
     }
 
     void Widget::eventResize() {
         if (freezed) { return; }
-        if (parent) { parent->resizeChildren(); }
-        resizeChildren();
-        freezed = true;
-        refresh();
-        freezed = false;
+        if (parent) { parent->invalidateLayout(); }
+        invalidateLayout();
+    }
+
+    void Widget::eventLayout() {
     }
 
     void Widget::resizeChildren() {
@@ -527,7 +801,9 @@ namespace lysa::ui {
         if (!enabled) {
             return false;
         }
-        ctx().events.push({UIEvent::OnTextInput, UIEventText{.text = text}, id});
+        if (isSignaled(UIEvent::ON_TEXT_INPUT)) {
+            UIEvent::push<UIEvent::ON_TEXT_INPUT>(id, UIEventText{.text = text});
+        }
         return false;
     }
 
@@ -535,7 +811,9 @@ namespace lysa::ui {
         if (!enabled || !isVisible()) {
             return false;
         }
-        ctx().events.push({UIEvent::OnKeyDown, UIEventKeyb{.key = key}, id});
+        if (isSignaled(UIEvent::ON_KEY_DOWN)) {
+            UIEvent::push<UIEvent::ON_KEY_DOWN>(id, UIEventKeyb{.key = key});
+        }
         return false;
     }
 
@@ -544,106 +822,136 @@ namespace lysa::ui {
             return false;
         }
         if (focused) {
-            ctx().events.push({UIEvent::OnKeyUp, UIEventKeyb{.key = key}, id});
+            if (isSignaled(UIEvent::ON_KEY_UP)) {
+                UIEvent::push<UIEvent::ON_KEY_UP>(id, UIEventKeyb{.key = key});
+            }
             return true;
         }
         return false;
     }
 
     bool Widget::eventMouseDown(const MouseButton button, const float x, const float y) {
-        if (!enabled || !isVisible() || !rect.contains(x, y)) { return false;}
-        pushed = true;
-        if (redrawOnMouseEvent) { resizeChildren();   }
+        if (!enabled || !childrenRect.contains(x, y) || !isVisible()) { return false;}
+        const auto inside = rect.contains(x, y);
+        if (inside) {
+            pushed = true;
+            // The children are only moved by a layout, the widget itself is repainted below
+            if (moveChildrenOnPush && !children.empty()) { invalidateLayout(); }
+        }
         auto consumed = false;
         Widget *wfocus = nullptr;
+        // Children positions are not translated by the children offset
+        const auto cx = x + childrenOffsetX;
+        const auto cy = y + childrenOffsetY;
+        const auto inClip = isInChildrenClip(x, y);
         for (auto &w : children) {
-            if (w->getRect().contains(x, y)) {
-                consumed |= w->eventMouseDown(button, x, y);
+            // Skips the whole subtree when the pointer is outside of its bounds
+            if (!inClip || !w->childrenRect.contains(cx, cy)) { continue; }
+            consumed |= w->eventMouseDown(button, cx, cy);
+            if (w->getRect().contains(cx, cy)) {
                 wfocus = w.get();
                 if (w->redrawOnMouseEvent) {
-                    w->refresh();
+                    w->invalidatePaint();
                 }
             }
         }
         if ((wfocus != nullptr) && (wfocus->allowFocus)) {
             wfocus->setFocus();
         }
+        if (!inside) {
+            // Only an overlapping descendant is under the pointer
+            return consumed;
+        }
         if (redrawOnMouseEvent) {
-            refresh();
+            invalidatePaint();
         }
         if (!consumed) {
-            ctx().events.push({
-                UIEvent::OnMouseDown,
-                UIEventMouseButton{.button = button, .x = x, .y = y},
-            id});
+            if (isSignaled(UIEvent::ON_MOUSE_DOWN)) {
+                UIEvent::push<UIEvent::ON_MOUSE_DOWN>(id, UIEventMouseButton{.button = button, .x = x, .y = y});
+            }
             return consumeMouseEvent;
         }
         return consumed;
     }
 
     bool Widget::eventMouseUp(const MouseButton button, const float x, const float y) {
-        if (!enabled || !isVisible() || !rect.contains(x, y)) { return false;}
-        pushed = false;
-        if (redrawOnMouseEvent) { resizeChildren(); }
+        if (!enabled || !childrenRect.contains(x, y) || !isVisible()) { return false;}
+        const auto inside = rect.contains(x, y);
+        if (inside) {
+            pushed = false;
+            // The children are only moved by a layout, the widget itself is repainted below
+            if (moveChildrenOnPush && !children.empty()) { invalidateLayout(); }
+        }
         auto consumed = false;
+        const auto cx = x + childrenOffsetX;
+        const auto cy = y + childrenOffsetY;
+        const auto inClip = isInChildrenClip(x, y);
         for (const auto &w : children) {
-            if (w->getRect().contains(x, y) || w->isPushed()) {
-                consumed |= w->eventMouseUp(button, x, y);
+            // Skips the whole subtree when the pointer is outside of its bounds
+            if ((inClip && w->childrenRect.contains(cx, cy)) || w->isPushed()) {
+                consumed |= w->eventMouseUp(button, cx, cy);
                 if (w->redrawOnMouseEvent) {
-                    w->refresh();
+                    w->invalidatePaint();
                 }
             }
         }
-        if (redrawOnMouseEvent) { refresh(); }
+        if (!inside) {
+            // Only an overlapping descendant is under the pointer
+            return consumed;
+        }
+        if (redrawOnMouseEvent) { invalidatePaint(); }
         if (!consumed) {
-            ctx().events.push(Event {
-                UIEvent::OnMouseUp,
-                UIEventMouseButton{ .button = button, .x = x, .y = y},
-                id});
+            if (isSignaled(UIEvent::ON_MOUSE_UP)) {
+                UIEvent::push<UIEvent::ON_MOUSE_UP>(id, UIEventMouseButton{.button = button, .x = x, .y = y});
+            }
             return consumeMouseEvent;
         }
         return consumed;
     }
 
     bool Widget::eventMouseMove(const uint32 B, const float x, const float y) {
-        auto p = rect.contains(x, y);
-        if (!enabled || !isVisible() || !p) { return false;}
+        if (!enabled || !childrenRect.contains(x, y) || !isVisible()) { return false;}
         auto consumed = false;
+        const auto cx = x + childrenOffsetX;
+        const auto cy = y + childrenOffsetY;
+        const auto inClip = isInChildrenClip(x, y);
         for (const auto &w : children) {
-            p = w->getRect().contains(x, y);
+            const auto p = inClip && w->getRect().contains(cx, cy);
             if (w->redrawOnMouseMove && (w->pointed != p)) {
                 w->pointed = p;
-                w->refresh();
+                w->invalidatePaint();
             }
-            if (p) {
-                consumed |= w->eventMouseMove(B, x, y);
+            // Skips the whole subtree when the pointer is outside of its bounds
+            if (inClip && w->childrenRect.contains(cx, cy)) {
+                consumed |= w->eventMouseMove(B, cx, cy);
             }
         }
-        if (redrawOnMouseMove && (pointed != p)) {
-            refresh();
+        if (!rect.contains(x, y)) {
+            // Only an overlapping descendant is under the pointer
+            return consumed;
         }
         if (!consumed) {
-            ctx().events.push({
-                UIEvent::OnMouseMove,
-                UIEventMouseMove{.buttonsState = B, .x = x, .y = y},
-            id});
+            if (isSignaled(UIEvent::ON_MOUSE_MOVE)) {
+                UIEvent::push<UIEvent::ON_MOUSE_MOVE>(id, UIEventMouseMove{.buttonsState = B, .x = x, .y = y});
+            }
             return consumeMouseEvent;
         }
         return consumed;
     }
 
     void Widget::eventGotFocus() {
-        if (!visible) { return; }
-        ctx().events.push({UIEvent::OnGotFocus,  UIEvent{}, id});
+        if (!visible || !isSignaled(UIEvent::ON_GOT_FOCUS)) { return; }
+        UIEvent::push<UIEvent::ON_GOT_FOCUS>(id, UIEvent{});
     }
 
     void Widget::eventLostFocus() {
-        ctx().events.push({UIEvent::OnLostFocus,  UIEvent{}, id});
+        if (!isSignaled(UIEvent::ON_LOST_FOCUS)) { return; }
+        UIEvent::push<UIEvent::ON_LOST_FOCUS>(id, UIEvent{});
     }
 
     void Widget::setTransparency(const float alpha) {
         transparency = alpha;
-        refresh();
+        invalidatePaint();
     }
 
     void Widget::setPadding(const float padding) {
@@ -653,7 +961,7 @@ namespace lysa::ui {
 
     void Widget::setDrawBackground(const bool drawBackground) {
         this->drawBackground = drawBackground;
-        refresh();
+        invalidatePaint();
     }
 
     void Widget::setAlignment(const Alignment alignment) {
@@ -663,16 +971,39 @@ namespace lysa::ui {
 
     void Widget::refresh() {
         if (freezed) { return; }
-        dirty = true;
+        invalidatePaint();
         for (const auto &w : children) {
             w->refresh();
         }
     }
 
+    void Widget::invalidatePaint() {
+        if (freezed) { return; }
+        setDirty(DIRTY_PAINT);
+    }
+
+    void Widget::invalidateLayout() {
+        if (freezed) { return; }
+        setDirty(DIRTY_LAYOUT);
+    }
+
+    void Widget::setDirty(const uint32 flags) {
+        dirty |= flags;
+        invalidateParents(flags & DIRTY_LAYOUT ? DIRTY_SUBTREE | DIRTY_SUBTREE_LAYOUT : DIRTY_SUBTREE);
+    }
+
+    void Widget::invalidateParents(const uint32 flags) const {
+        // Stops on the first ancestor already flagged : all of its own ancestors are flagged too
+        auto p = parent;
+        while ((p != nullptr) && ((p->dirty & flags) != flags)) {
+            p->dirty |= flags;
+            p = p->parent;
+        }
+    }
+
     void Widget::setFont(const std::shared_ptr<Font> &font) {
         this->font = font;
-        resizeChildren();
-        refresh();
+        invalidateLayout();
     }
 
     float Widget::getFontScale() const {
@@ -681,8 +1012,7 @@ namespace lysa::ui {
 
     void Widget::setFontScale(const float fontScale) {
         this->fontScale = fontScale;
-        resizeChildren();
-        refresh();
+        invalidateLayout();
     }
 
     void Widget::setGroupIndex(const int32 index) { groupIndex = index; }
@@ -725,27 +1055,36 @@ namespace lysa::ui {
     float Widget::getHBorder() const { return hborder; }
 
     void Widget::setVBorder(const float size) {
+        if (vborder == size) { return; }
         vborder = size;
-        if (!freezed) {
-            resizeChildren();
-        }
-        refresh();
+        invalidateLayout();
     }
 
     void Widget::setHBorder(const float size) {
+        if (hborder == size) { return; }
         hborder = size;
-        if (!freezed) {
-            resizeChildren();
-        }
-        refresh();
+        invalidateLayout();
     }
 
     void Widget::setChildrenOffset(const float x, const float y) {
         if ((childrenOffsetX == x) && (childrenOffsetY == y)) { return; }
         childrenOffsetX = x;
         childrenOffsetY = y;
-        resizeChildren();
-        refresh();
+        // No layout : the descendants are only recorded again with the new translation
+        setDirty(DIRTY_OFFSET);
+        if (offsetChildrenRect()) {
+            for (auto p = parent; (p != nullptr) && p->updateChildrenRect(); p = p->parent) {}
+        }
+    }
+
+    void Widget::setClipChildren(const bool clip) {
+        if (clipChildren == clip) { return; }
+        clipChildren = clip;
+        // Culls or restores the descendants on the next frame
+        setDirty(DIRTY_OFFSET);
+        if (offsetChildrenRect()) {
+            for (auto p = parent; (p != nullptr) && p->updateChildrenRect(); p = p->parent) {}
+        }
     }
 
     uint32 Widget::getGroupIndex() const { return groupIndex; }
@@ -13,8 +13,9 @@ import lysa.context;
 import lysa.exception;
 import lysa.rect;
 import lysa.input_event;
+import lysa.math;
 import lysa.types;
-import lysa.renderers.vector_2d;
+import lysa.ui.renderer;
 import lysa.resources;
 import lysa.resources.font;
 import lysa.ui.alignment;
@@ -22,6 +23,37 @@ import lysa.ui.uiresource;
 
 export namespace lysa::ui {
 
+    /**
+     * Allocator of the objects created in a Window arena (see Window::enableArena()).
+     *
+     * Each allocation shares the ownership of the arena : the control blocks of the shared
+     * pointers keep it alive, and the arena is destroyed with the last widget, resource or
+     * weak reference allocated from it.
+     */
+    template <typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        ArenaAllocator(const std::shared_ptr<std::pmr::memory_resource>& arena) : arena{arena} {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena{other.arena} {}
+
+        T* allocate(const size_t n) {
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* ptr, const size_t n) {
+            arena->deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+
+        template <typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+        std::shared_ptr<std::pmr::memory_resource> arena;
+    };
+
     /**
      * Base class for all UI widgets.
      */
@@ -67,6 +99,10 @@ export namespace lysa::ui {
             PROGRESSBAR,
             //! %A scrollable container (horizontal & vertical)
             SCROLLBOX,
+            //! Row of a TREEVIEW with an indented expand handle (internal to TREEVIEW)
+            TREEVIEWROW,
+            //! %A multi-line text edit field
+            TEXTAREA,
         };
 
         /**
@@ -83,7 +119,7 @@ export namespace lysa::ui {
         Type getType() const;
 
         /**
-         * Returns true if the widget is visible.
+         * Returns true if the widget, all its parents and its window are visible.
          */
         bool isVisible() const;
 
@@ -170,6 +206,15 @@ export namespace lysa::ui {
          */
         void setFont(const std::shared_ptr<Font>& font);
 
+        /**
+         * Returns the size of a text drawn with the font & the font scale of the widget,
+         * using the text measure cache of the window manager.
+         * @param text The text to measure.
+         * @param width Output width.
+         * @param height Output height.
+         */
+        void measureText(const std::string& text, float& width, float& height) const;
+
         /**
          * Returns the font scale.
          */
@@ -205,7 +250,7 @@ export namespace lysa::ui {
             const Alignment alignment,
             Args&&... args) {
             return add(
-                std::make_shared<T>(std::forward<Args>(args)...),
+                make<T>(std::forward<Args>(args)...),
                 alignment,
                 resource);
         }
@@ -223,10 +268,28 @@ export namespace lysa::ui {
             const Alignment alignment,
             Args&&... args) {
             return add(
-                std::make_shared<T>(std::forward<Args>(args)...),
+                make<T>(std::forward<Args>(args)...),
                 alignment);
         }
 
+        /**
+         * Creates a widget without adding it.
+         *
+         * The widget is allocated from the window arena when enabled (see Window::enableArena()),
+         * from the heap otherwise.
+         * @tparam T The type of the widget to create.
+         * @tparam Args The types of the arguments to pass to the widget constructor.
+         * @param args The arguments to pass to the widget constructor.
+         * @return A shared pointer to the created widget.
+         */
+        template<typename T, typename... Args>
+        std::shared_ptr<T> make(Args&&... args) const {
+            if (arena != nullptr) {
+                return std::allocate_shared<T>(ArenaAllocator<T>{arena}, std::forward<Args>(args)...);
+            }
+            return std::make_shared<T>(std::forward<Args>(args)...);
+        }
+
         /**
          * Adds a child widget.
          *
@@ -256,6 +319,11 @@ export namespace lysa::ui {
          */
         virtual void remove(const std::shared_ptr<Widget> &child);
 
+        /**
+         * Removes a set of children widgets in one pass over the children list.
+         */
+        void removeChildren(std::span<const std::shared_ptr<Widget>> removed);
+
         /**
          * Removes all children widgets recursively.
          */
@@ -327,7 +395,11 @@ export namespace lysa::ui {
         bool isOverlapping() const { return overlap; }
 
         /**
-         * Returns the rectangle enclosing all children.
+         * Returns the rectangle enclosing the widget and all its descendants,
+         * including the overlapping ones (popups) placed outside of the widget.
+         * The descendants bounds are translated by the children offset and are
+         * ignored when the children are clipped, see setClipChildren().
+         * Updated by the layout pass and by setChildrenOffset().
          */
         Rect getChildrenRect() const;
 
@@ -342,10 +414,23 @@ export namespace lysa::ui {
         void setPushed(const bool p) { pushed = p; }
 
         /**
-         * Force a refresh of the entire widget.
+         * Force a refresh of the entire widget, including all the children widgets.
          */
         void refresh();
 
+        /**
+         * Re-records the widget's own drawing on the next frame, without touching the children widgets.
+         */
+        void invalidatePaint();
+
+        /**
+         * Requests a layout of the children widgets.
+         *
+         * The layout is deferred to the once-per-frame layout pass run by the
+         * WindowManager before drawing, so successive changes are merged into a single layout.
+         */
+        void invalidateLayout();
+
         /**
          * Changes widget resources.
          */
@@ -394,27 +479,46 @@ export namespace lysa::ui {
         void setTransparency(float alpha);
 
         /**
-         * Resizes children widgets.
+         * Immediately lays out the children widgets.
+         *
+         * Prefer invalidateLayout() which defers the layout to the next frame.
          */
         void resizeChildren();
 
         /**
-         * Returns the horizontal children scroll offset (subtracted from child positions).
+         * Returns the horizontal children scroll offset (subtracted from the drawn child positions).
          */
         float getChildrenOffsetX() const { return childrenOffsetX; }
 
         /**
-         * Returns the vertical children scroll offset (subtracted from child positions).
+         * Returns the vertical children scroll offset (subtracted from the drawn child positions).
          */
         float getChildrenOffsetY() const { return childrenOffsetY; }
 
         /**
-         * Sets the children scroll offset. Children are laid out by resizeChildren()
-         * starting from the client rect minus this offset, enabling scrollable content.
+         * Sets the children scroll offset, enabling scrollable content.
+         * The children keep their layout : the offset is applied when hit-testing them and as the
+         * translation of their draw sessions, without any layout pass. The renderer applies the
+         * translation of a session when recording it and can't move a recorded session : each
+         * change records again the sessions of the descendants inside the clip, the culled
+         * descendants are skipped. For long lists, use the virtual mode of ListBox or TreeView,
+         * which only moves the displayed rows.
          * Default is (0, 0): no effect.
          */
         void setChildrenOffset(float x, float y);
 
+        /**
+         * Returns true if the children are clipped to the client area.
+         */
+        bool isClipChildren() const { return clipChildren; }
+
+        /**
+         * Clips the children to the client area (the widget rect minus the borders).
+         * The descendants entirely outside of the clip are neither recorded nor drawn,
+         * and the pointer events outside of the clip are not sent to the children.
+         */
+        void setClipChildren(bool clip);
+
         /**
          * Requests keyboard focus for this widget.
          * @param focus True to request focus, false to release it.
@@ -431,7 +535,7 @@ export namespace lysa::ui {
          * Called before the widget is destroyed.
          * @param renderer The 2D renderer to release any associated resources.
          */
-        virtual void eventDestroy(Vector2DRenderer& renderer);
+        virtual void eventDestroy(UIRenderer& renderer);
 
         /**
          * Called when the widget becomes visible.
@@ -465,6 +569,18 @@ export namespace lysa::ui {
          */
         virtual void eventResize();
 
+        /**
+         * Called when the position or the size of a child changed.
+         * @param child The moved or resized child.
+         * @param previous The rect of the child before the change.
+         */
+        virtual void eventChildRectChange(const Widget& child, const Rect& previous) {}
+
+        /**
+         * Called by the layout pass after the children widgets have been laid out.
+         */
+        virtual void eventLayout();
+
         /**
          * Called on a text input event.
          * @param text The input text.
@@ -535,17 +651,60 @@ export namespace lysa::ui {
             this->consumeMouseEvent = consumeMouseEvent;
         }
 
+        /**
+         * Declares a handler subscribed to a signal of the widget.
+         *
+         * The lifecycle & input signals (create, destroy, show, hide, enable, disable, focus,
+         * keyboard, text input & mouse) are only pushed for the widgets with at least one
+         * declared handler, once setSignalUndeclared() is disabled. UIEvent::subscribe() declares
+         * the handlers itself : call this function for the handlers subscribed directly to the
+         * engine events queue.
+         * @param event The UIEvent::Id of the signal.
+         */
+        void addSubscription(uint8 event);
+
+        /**
+         * Removes a handler declared with addSubscription().
+         * @param event The UIEvent::Id of the signal.
+         */
+        void removeSubscription(uint8 event);
+
+        /**
+         * Returns true if at least one handler is declared for a signal of the widget.
+         * @param event The UIEvent::Id of the signal.
+         */
+        bool isSubscribed(const uint8 event) const { return (subscribedEvents & (1u << event)) != 0; }
+
+        /**
+         * Pushes the lifecycle & input signals of all the widgets, with or without a declared
+         * handler. Enabled by default for the handlers subscribed directly to the engine events
+         * queue with the signal names, like `ctx().events.subscribe(UIEvent::OnMouseDown, ...)`.
+         * @deprecated Declare these handlers with addSubscription() or use UIEvent::subscribe(),
+         * then disable it. It will be disabled by default in the next release.
+         */
+        static void setSignalUndeclared(const bool signal) { signalUndeclared = signal; }
+
+        /**
+         * Returns true if the lifecycle & input signals are pushed without a declared handler.
+         */
+        static bool isSignalUndeclared() { return signalUndeclared; }
+
         void _allowFocus(bool allow = true);
 
         void _setRedrawOnMouseEvent(const bool r) { redrawOnMouseEvent = r; }
 
         void _setMoveChildrenOnPush(const bool r) { moveChildrenOnPush = r; }
 
-        const std::list<std::shared_ptr<Widget>>& getChildren() const { return children; }
+        const std::pmr::list<std::shared_ptr<Widget>>& getChildren() const { return children; }
+
+        virtual std::pmr::list<std::shared_ptr<Widget>>& _getChildren() { return children; }
+
+        void _draw(UIRenderer &renderer, const float2& translate, const Rect& clip, bool force = false);
 
-        virtual std::list<std::shared_ptr<Widget>>& _getChildren() { return children; }
+        void _layout();
 
-        void _draw(Vector2DRenderer &renderer);
+        // Returns true if the widget or one of its descendants still needs a layout
+        bool _isLayoutPending() const { return (dirty & (DIRTY_LAYOUT | DIRTY_SUBTREE_LAYOUT)) != 0; }
 
         void _setWindow(void* window) { this->window = window; }
 
@@ -553,6 +712,17 @@ export namespace lysa::ui {
 
         void* _getStyle() const { return style; }
 
+        // Deletes the draw sessions of the widget & its descendants, recorded again by the next draw
+        void _resetDrawSessions();
+
+        // Adds back a child removed from a widget of the same Window without initializing it again :
+        // the child keeps its resource & size. Returns false if the child must be added with add()
+        bool _reattach(const std::shared_ptr<Widget>& child, Alignment alignment);
+
+        void _setArena(const std::shared_ptr<std::pmr::memory_resource>& arena);
+
+        const auto& _getArena() const { return arena; }
+
         bool _isMouseMoveOnFocus() const { return mouseMoveOnFocus; }
 
     protected:
@@ -575,13 +745,15 @@ export namespace lysa::ui {
         Widget* parent{nullptr};
         Alignment alignment{Alignment::NONE};
         std::shared_ptr<UIResource> resource;
-        std::list<std::shared_ptr<Widget>> children;
+        std::pmr::list<std::shared_ptr<Widget>> children;
         void* window{nullptr};
         void* style{nullptr};
+        std::shared_ptr<std::pmr::memory_resource> arena{nullptr};
         bool mouseMoveOnFocus{false};
         float fontScale{0.0f};
         float childrenOffsetX{0};
         float childrenOffsetY{0};
+        bool clipChildren{false};
 
         // virtual Rect _getDefaultRect() { return defaultRect; }
 
@@ -593,20 +765,74 @@ export namespace lysa::ui {
         bool freezed{true};
         bool enabled{true};
         bool visible{true};
+        // Own visibility combined with the ancestors' one, pushed down by changeDrawVisibility()
+        bool effectiveVisible{true};
+        // Outside of the clip of an ancestor : the sessions are hidden and not recorded
+        bool culled{false};
+        // Bitmask of the signals with at least one declared handler, indexed by UIEvent::Id
+        uint32 subscribedEvents{0};
+        // See setSignalUndeclared()
+        static inline bool signalUndeclared{true};
+        // One UIEvent::Id per declared handler
+        std::vector<uint8> subscriptions;
         void *userData{nullptr};
 #ifdef LUA_BINDINGS
         luabridge::LuaRef luaUserData{nullptr};
 #endif
         int32 groupIndex{0};
         Rect childrenRect;
+        // Bounds of the children subtrees before the children offset, width < 0 without visible children
+        Rect contentRect{0.0f, 0.0f, -1.0f, -1.0f};
         std::shared_ptr<Font> font{nullptr};
-        bool dirty{true};
+
+        /*
+         * Invalidation flags, consumed by _draw()
+         */
+        enum Dirty : uint32 {
+            DIRTY_NONE           = 0b00000,
+            DIRTY_PAINT          = 0b00001, // own before/after draw sessions must be re-recorded
+            DIRTY_LAYOUT         = 0b00010, // own position, size or client area changed, children must be laid out
+            DIRTY_SUBTREE        = 0b00100, // at least one descendant is dirty
+            DIRTY_SUBTREE_LAYOUT = 0b01000, // at least one descendant needs a layout
+            DIRTY_OFFSET         = 0b10000, // children offset changed, the descendants sessions must be re-recorded
+        };
+        uint32 dirty{DIRTY_PAINT | DIRTY_LAYOUT};
         unique_id drawSessionBefore{INVALID_ID};
         unique_id drawSessionAfter{INVALID_ID};
 
         void clearDrawSessions() const;
 
-        void changeDrawVisibility() const;
+        void setDirty(uint32 flags);
+
+        bool updateChildrenRect();
+
+        // Updates childrenRect from contentRect & the children offset, returns true if it changed
+        bool offsetChildrenRect();
+
+        void invalidateParents(uint32 flags) const;
+
+        void changeDrawVisibility(bool culledParent);
+
+        // Recomputes effectiveVisible for the widget & all its descendants
+        void updateEffectiveVisible();
+
+        // Returns true if a lifecycle or input signal must be pushed, see setSignalUndeclared()
+        bool isSignaled(const uint8 event) const { return signalUndeclared || isSubscribed(event); }
+
+        // Returns true if the widget or one of its ancestors is culled
+        bool isCulled() const;
+
+        // Returns the clip applied to the children, in the children coordinates
+        Rect getChildrenClip(const Rect& clip) const;
+
+        // Creates empty sessions for a culled subtree to keep the drawing order of the sessions
+        void reserveDrawSessions(UIRenderer &renderer);
+
+        // Returns true if the widget and all its descendants are outside of a clip
+        bool isClipped(const Rect& clip) const;
+
+        // Returns true if a point, in the widget coordinates, is not clipped for the children
+        bool isInChildrenClip(float x, float y) const;
 
         std::shared_ptr<Widget> setNextFocus();
     };
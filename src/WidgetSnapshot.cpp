@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+module lysa.ui.widget_snapshot;
+
+namespace lysa::ui {
+
+    std::optional<std::string_view> WidgetSnapshot::getText(const unique_id widget) const {
+        const auto it = values.find(widget);
+        if (it == values.end()) { return std::nullopt; }
+        if (const auto* text = std::get_if<std::string>(&it->second.value)) { return *text; }
+        return std::nullopt;
+    }
+
+    WidgetSnapshots::WidgetSnapshots() {
+        snapshots.push_back(std::make_unique<WidgetSnapshot>());
+        current.store(snapshots.back().get());
+    }
+
+    WidgetSnapshots::Reader WidgetSnapshots::get() const {
+        while (true) {
+            auto* snapshot = current.load();
+            snapshot->readers.fetch_add(1);
+            // Once counted, a snapshot still published is not reused until the reader is destroyed
+            if (current.load() == snapshot) { return Reader{snapshot}; }
+            // Published again between the two loads
+            snapshot->readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void WidgetSnapshots::watch(const std::shared_ptr<ValueSelect>& widget) {
+        watch(widget, [](const Widget& w) -> WidgetSnapshot::Value {
+            return static_cast<const ValueSelect&>(w).getValue();
+        });
+    }
+
+    void WidgetSnapshots::watch(const std::shared_ptr<TextEdit>& widget) {
+        watch(widget, [](const Widget& w) -> WidgetSnapshot::Value {
+            return static_cast<const TextEdit&>(w).getText();
+        }, [](const Widget& w) -> uint64 {
+            return static_cast<const TextEdit&>(w).getTextRevision();
+        });
+    }
+
+    void WidgetSnapshots::watch(const std::shared_ptr<List>& widget) {
+        watch(widget, [](const Widget& w) -> WidgetSnapshot::Value {
+            return static_cast<const List&>(w).getSelectedIndex();
+        });
+    }
+
+    void WidgetSnapshots::watch(
+        const std::shared_ptr<Widget>& widget,
+        WidgetSnapshot::Value (*capture)(const Widget&),
+        uint64 (*revision)(const Widget&)) {
+        unwatch(*widget);
+        watched.push_back({widget->id, widget, capture, revision});
+        watchedVersion += 1;
+    }
+
+    void WidgetSnapshots::unwatch(const Widget& widget) {
+        if (std::erase_if(watched, [&](const Watched& w) { return w.id == widget.id; }) > 0) {
+            watchedVersion += 1;
+        }
+    }
+
+    bool WidgetSnapshots::isChanged(const Watched& watched, const Widget& widget, const WidgetSnapshot& published) {
+        const auto it = published.values.find(watched.id);
+        if (it == published.values.end()) { return true; }
+        if (watched.revision != nullptr) {
+            return watched.revision(widget) != it->second.revision;
+        }
+        return watched.capture(widget) != it->second.value;
+    }
+
+    WidgetSnapshot& WidgetSnapshots::getFreeSnapshot() {
+        const auto* published = current.load(std::memory_order_relaxed);
+        for (const auto& snapshot : snapshots) {
+            if ((snapshot.get() != published) && (snapshot->readers.load() == 0)) {
+                return *snapshot;
+            }
+        }
+        // All the snapshots are read
+        snapshots.push_back(std::make_unique<WidgetSnapshot>());
+        return *snapshots.back();
+    }
+
+    void WidgetSnapshots::publish() {
+        frame += 1;
+        if (std::erase_if(watched, [](const Watched& w) { return w.widget.expired(); }) > 0) {
+            watchedVersion += 1;
+        }
+        const auto& published = *current.load(std::memory_order_relaxed);
+        auto changed = published.watchedVersion != watchedVersion;
+        for (size_t i = 0; (i < watched.size()) && !changed; i++) {
+            changed = isChanged(watched[i], *watched[i].widget.lock(), published);
+        }
+        if (!changed) { return; }
+
+        auto& snapshot = getFreeSnapshot();
+        if (snapshot.watchedVersion != watchedVersion) {
+            snapshot.values.clear();
+            snapshot.watchedVersion = watchedVersion;
+        }
+        snapshot.frame = frame;
+        for (const auto& w : watched) {
+            const auto widget = w.widget.lock();
+            auto& entry = snapshot.values[w.id];
+            if (w.revision != nullptr) {
+                // The unchanged states are not captured again
+                const auto revision = w.revision(*widget);
+                if (entry.revision == revision) { continue; }
+                if (const auto it = published.values.find(w.id);
+                    (it != published.values.end()) && (it->second.revision == revision)) {
+                    entry = it->second;
+                    continue;
+                }
+                entry.revision = revision;
+            }
+            entry.value = w.capture(*widget);
+        }
+        current.store(&snapshot);
+    }
+
+}
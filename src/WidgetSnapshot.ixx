@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+export module lysa.ui.widget_snapshot;
+
+import std;
+import lysa.types;
+import lysa.ui.list;
+import lysa.ui.text_edit;
+import lysa.ui.value_select;
+import lysa.ui.widget;
+
+export namespace lysa::ui {
+
+    /**
+     * Copy of the state of the watched widgets, captured by the UI thread at the end of a frame.
+     * A snapshot is not modified while it is read, see WidgetSnapshots::get().
+     */
+    class WidgetSnapshot {
+    public:
+        //! Captured state of a widget
+        using Value = std::variant<float, int32, std::string>;
+
+        /**
+         * Returns the number of the frame the values were captured at, the last frame where
+         * one of them changed.
+         */
+        auto getFrame() const { return frame; }
+
+        /**
+         * Returns the value of a watched ValueSelect (ScrollBar, TrackBar, ProgressBar, ...).
+         */
+        std::optional<float> getValue(unique_id widget) const { return get<float>(widget); }
+
+        /**
+         * Returns the text of a watched TextEdit. The view is valid as long as the snapshot is read.
+         */
+        std::optional<std::string_view> getText(unique_id widget) const;
+
+        /**
+         * Returns the selected index of a watched List.
+         */
+        std::optional<int32> getSelectedIndex(unique_id widget) const { return get<int32>(widget); }
+
+    private:
+        static constexpr uint64 NO_REVISION{std::numeric_limits<uint64>::max()};
+
+        struct Entry {
+            Value value;
+            // Revision of the widget state for the widgets with a revision counter
+            uint64 revision{NO_REVISION};
+        };
+
+        uint64 frame{0};
+        // Version of the watched widgets list the entries were captured for
+        uint64 watchedVersion{0};
+        std::unordered_map<unique_id, Entry> values;
+        // Number of readers of the snapshot, the UI thread only reuses the snapshots without readers
+        mutable std::atomic<uint32> readers{0};
+
+        template <typename T>
+        std::optional<T> get(const unique_id widget) const {
+            const auto it = values.find(widget);
+            if (it == values.end()) { return std::nullopt; }
+            if (const auto* value = std::get_if<T>(&it->second.value)) { return *value; }
+            return std::nullopt;
+        }
+
+        friend class WidgetSnapshots;
+    };
+
+    /**
+     * Publishes the snapshots of the watched widgets for the worker threads.
+     *
+     * The UI thread captures the watched widgets at the end of each frame into a snapshot
+     * without readers and publishes it with an atomic pointer. A reader counts itself on the
+     * published snapshot and checks that it is still the published one : the readers get a
+     * consistent state of all the widgets of a frame without taking a lock, and the UI thread
+     * never waits for them. The snapshots are kept in a pool, only grown when all of them are
+     * read, and a new snapshot is only captured when a value changed.
+     */
+    class WidgetSnapshots {
+    public:
+        /**
+         * Read access to the published snapshot, the snapshot is not modified until the reader is destroyed.
+         */
+        class Reader {
+        public:
+            Reader(Reader&& other) noexcept : snapshot{std::exchange(other.snapshot, nullptr)} {}
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+            Reader& operator=(Reader&&) = delete;
+
+            ~Reader() {
+                if (snapshot != nullptr) { snapshot->readers.fetch_sub(1, std::memory_order_release); }
+            }
+
+            const WidgetSnapshot* operator->() const { return snapshot; }
+
+            const WidgetSnapshot& operator*() const { return *snapshot; }
+
+        private:
+            const WidgetSnapshot* snapshot;
+
+            Reader(const WidgetSnapshot* snapshot) : snapshot{snapshot} {}
+
+            friend class WidgetSnapshots;
+        };
+
+        WidgetSnapshots();
+
+        /**
+         * Captures the value of a ValueSelect in the snapshots. Must be called from the UI thread.
+         */
+        void watch(const std::shared_ptr<ValueSelect>& widget);
+
+        /**
+         * Captures the text of a TextEdit in the snapshots, only when the text changed.
+         * Must be called from the UI thread.
+         */
+        void watch(const std::shared_ptr<TextEdit>& widget);
+
+        /**
+         * Captures the selected index of a List in the snapshots. Must be called from the UI thread.
+         */
+        void watch(const std::shared_ptr<List>& widget);
+
+        /**
+         * Removes a widget from the snapshots, starting with the next published one.
+         * The destroyed widgets are removed automatically. Must be called from the UI thread.
+         */
+        void unwatch(const Widget& widget);
+
+        /**
+         * Returns a reader of the last published snapshot. Can be called from any thread.
+         * The readers must be destroyed before the WindowManager.
+         */
+        Reader get() const;
+
+        /**
+         * Captures the watched widgets and publishes a new snapshot if a value changed.
+         * Called by the WindowManager at the end of each frame.
+         */
+        void publish();
+
+    private:
+        struct Watched {
+            unique_id id;
+            std::weak_ptr<Widget> widget;
+            WidgetSnapshot::Value (*capture)(const Widget&);
+            // Returns a counter changed with the state, nullptr to compare the captured values
+            uint64 (*revision)(const Widget&);
+        };
+
+        uint64 frame{0};
+        std::vector<Watched> watched;
+        // Changed with the watched widgets list
+        uint64 watchedVersion{0};
+        // All the snapshots, published or not
+        std::vector<std::unique_ptr<WidgetSnapshot>> snapshots;
+        std::atomic<WidgetSnapshot*> current;
+
+        void watch(
+            const std::shared_ptr<Widget>& widget,
+            WidgetSnapshot::Value (*capture)(const Widget&),
+            uint64 (*revision)(const Widget&) = nullptr);
+
+        // Returns true if the state of a widget changed since the published snapshot
+        static bool isChanged(const Watched& watched, const Widget& widget, const WidgetSnapshot& published);
+
+        // Returns a snapshot without readers other than the published one
+        WidgetSnapshot& getFreeSnapshot();
+    };
+
+}
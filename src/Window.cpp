@@ -9,7 +9,7 @@ module lysa.ui.window;
 import lysa.exception;
 import lysa.log;
 import lysa.rect;
-import lysa.renderers.vector_2d;
+import lysa.ui.renderer;
 import lysa.resources.font;
 import lysa.ui.event;
 import lysa.ui.panel;
@@ -31,6 +31,13 @@ namespace lysa::ui {
         this->textColor = static_cast<WindowManager*>(windowManager)->getDefaultTextColor();
     }
 
+    void Window::enableArena() {
+        assert([&]{ return widget == nullptr;} , "ui::Window arena must be enabled before adding the Window to a Window manager");
+        if (arena == nullptr) {
+            arena = std::make_shared<std::pmr::synchronized_pool_resource>();
+        }
+    }
+
     void Window::_detach() {
         windowManager = nullptr;
     }
@@ -42,18 +49,28 @@ namespace lysa::ui {
         }
     }
 
-    Vector2DRenderer& Window::getRenderer() const {
+    UIRenderer& Window::getRenderer() const {
         return static_cast<WindowManager*>(windowManager)->getRenderer();
     }
 
+    void Window::layoutWidgets() const {
+        if (!isVisible() || (widget == nullptr)) {
+            return;
+        }
+        // The widgets created or moved by a layout (the recycled rows of the virtual lists)
+        // are laid out by another pass before being drawn
+        for (auto pass = 0; (pass < MAX_LAYOUT_PASSES) && widget->_isLayoutPending(); pass++) {
+            widget->_layout();
+        }
+    }
+
     void Window::draw() {
         if (!isVisible()) {
             return;
         }
-        Vector2DRenderer& renderer = static_cast<WindowManager*>(windowManager)->getRenderer();
-        renderer.setTranslate({rect.x, rect.y});
+        UIRenderer& renderer = static_cast<WindowManager*>(windowManager)->getRenderer();
         renderer.setTransparency(1.0f - transparency);
-        widget->_draw(renderer);
+        widget->_draw(renderer, {rect.x, rect.y}, widget->getChildrenRect());
     }
 
     void Window::unFreeze(const std::shared_ptr<Widget> &widget) {
@@ -85,11 +102,14 @@ namespace lysa::ui {
         assert([&]{ return windowManager != nullptr;} , "ui::Window must be added to a Window manager before setting the main widget");
         if (layout == nullptr) { setStyle(nullptr); }
         if (child == nullptr) {
-            widget = std::make_shared<Widget>();
+            widget = arena != nullptr ?
+                std::allocate_shared<Widget>(ArenaAllocator<Widget>{arena}) :
+                std::make_shared<Widget>();
         } else {
             widget = std::move(child);
         }
         widget->setFreezed( true);
+        if (arena != nullptr) { widget->_setArena(arena); }
         widget->setPadding(padding);
         widget->_setWindow(this);
         widget->_setStyle(layout.get());
@@ -134,13 +154,15 @@ namespace lysa::ui {
         setWidget();
         onCreate();
         // emit(UIEvent::OnCreate);
-        if (widget != nullptr) { widget->resizeChildren(); }
+        if (widget != nullptr) { widget->invalidateLayout(); }
     }
 
-    void Window::eventDestroy(Vector2DRenderer& renderer) {
+    void Window::eventDestroy(UIRenderer& renderer) {
         if (widget) { widget->eventDestroy(renderer); }
         // emit(UIEvent::OnDestroy);
         onDestroy();
+        focusedWidget.reset();
+        // The arena is released with the last reference to one of its widgets
         widget.reset();
     }
 
@@ -162,10 +184,8 @@ namespace lysa::ui {
             consumed |= onKeyDown(K);
         }
         if (!consumed) {
-            auto event = UIEventKeyb{.key = K};
-            ctx().events.push({UIEvent::OnKeyDown, event, id});
+            UIEvent::push<UIEvent::ON_KEY_DOWN>(id, UIEventKeyb{.key = K});
         }
-        refresh();
         return consumed;
     }
 
@@ -180,10 +200,8 @@ namespace lysa::ui {
             consumed |= onKeyUp(K);
         }
         if (!consumed) {
-            auto event = UIEventKeyb{.key = K};
-            ctx().events.push({UIEvent::OnKeyUp, event, id});
+            UIEvent::push<UIEvent::ON_KEY_UP>(id, UIEventKeyb{.key = K});
         }
-        refresh();
         return consumed;
     }
 
@@ -198,10 +216,8 @@ namespace lysa::ui {
             consumed |= onTextInput(text);
         }
         if (!consumed) {
-            auto event = UIEventText{.text = text};
-            ctx().events.push({UIEvent::OnTextInput, event, id});
+            UIEvent::push<UIEvent::ON_TEXT_INPUT>(id, UIEventText{.text = text});
         }
-        refresh();
         return consumed;
     }
 
@@ -215,9 +231,8 @@ namespace lysa::ui {
             consumed |= onMouseDown(B, X, Y);
         }
         if (!consumed) {
-            ctx().events.push({UIEvent::OnMouseDown, UIEventMouseButton{.button = B, .x = X, .y = Y}, id});
+            UIEvent::push<UIEvent::ON_MOUSE_DOWN>(id, UIEventMouseButton{.button = B, .x = X, .y = Y});
         }
-        refresh();
         return consumed;
     }
 
@@ -231,9 +246,8 @@ namespace lysa::ui {
             consumed |= onMouseUp(B, X, Y);
         }
         if (!consumed) {
-            ctx().events.push({UIEvent::OnMouseUp, UIEventMouseButton{.button = B, .x = X, .y = Y}, id});
+            UIEvent::push<UIEvent::ON_MOUSE_UP>(id, UIEventMouseButton{.button = B, .x = X, .y = Y});
         }
-        refresh();
         return consumed;
     }
 
@@ -250,9 +264,8 @@ namespace lysa::ui {
             consumed |= onMouseMove(B, X, Y);
         }
         if (!consumed) {
-            ctx().events.push({UIEvent::OnMouseMove, UIEventMouseMove{.buttonsState = B, .x = X, .y = Y}, id});
+            UIEvent::push<UIEvent::ON_MOUSE_MOVE>(id, UIEventMouseMove{.buttonsState = B, .x = X, .y = Y});
         }
-        if (consumed) { refresh(); }
         return consumed;
     }
 
@@ -330,7 +343,7 @@ namespace lysa::ui {
     }
 
     void Window::eventMove() {
-        if (widget) { widget->resizeChildren(); }
+        if (widget) { widget->invalidateLayout(); }
         onMove();
         // emit(UIEvent::OnMove);
         refresh();
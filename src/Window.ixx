@@ -11,6 +11,7 @@ import lysa.input_event;
 import lysa.math;
 import lysa.rect;
 import lysa.renderers.vector_2d;
+import lysa.ui.renderer;
 import lysa.resources;
 import lysa.resources.font;
 import lysa.ui.alignment;
@@ -35,6 +36,9 @@ export namespace lysa::ui {
             RESIZEABLE_BOTTOM = 0b1000, //! Bottom border resizable
         };
 
+        //! Maximum number of layout passes per frame, bounds the widgets invalidating their layout in eventLayout()
+        static constexpr int MAX_LAYOUT_PASSES{4};
+
         /**
          * Creates a virtual UI window with a given position & size.
          * @param rect The initial rectangle (position and size).
@@ -101,7 +105,7 @@ export namespace lysa::ui {
             const Alignment alignment,
             Args&&... args) {
             return add(
-                std::make_shared<T>(std::forward<Args>(args)...),
+                getWidget().make<T>(std::forward<Args>(args)...),
                 alignment,
                 resource);
         }
@@ -119,7 +123,7 @@ export namespace lysa::ui {
             const Alignment alignment,
             Args&&... args) {
             return add(
-                std::make_shared<T>(std::forward<Args>(args)...),
+                getWidget().make<T>(std::forward<Args>(args)...),
                 alignment);
         }
 
@@ -143,6 +147,22 @@ export namespace lysa::ui {
             return getWidget().add(child, alignment, resource, overlap);
         }
 
+        /**
+         * Allocates the widgets created with create(), their style resources and their
+         * children lists from a memory pool shared by the Window and its widgets, released
+         * in one go with the last widget or weak reference to a widget.
+         *
+         * Must be called before adding the Window to the Window manager. The pool is
+         * synchronized : the references to the widgets can be released from any thread,
+         * for example by the threads posting mutations with WindowManager::post().
+         */
+        void enableArena();
+
+        /**
+         * Returns true if the widgets are allocated from the Window memory pool.
+         */
+        bool isArenaEnabled() const { return arena != nullptr; }
+
         /**
          * Removes a child widget.
          */
@@ -405,7 +425,7 @@ export namespace lysa::ui {
 
         void eventCreate();
 
-        void eventDestroy(Vector2DRenderer& renderer);
+        void eventDestroy(UIRenderer& renderer);
 
         void eventShow();
 
@@ -431,6 +451,8 @@ export namespace lysa::ui {
 
         void eventLostFocus();
 
+        void layoutWidgets() const;
+
         void draw();
 
         void attach(void* windowManager);
@@ -454,7 +476,7 @@ export namespace lysa::ui {
         /**
          * Returns the 2D renderer associated with this Window.
          */
-        Vector2DRenderer& getRenderer() const;
+        UIRenderer& getRenderer() const;
 
     private:
         Rect rect;
@@ -474,6 +496,8 @@ export namespace lysa::ui {
         bool visibilityChange{false};
         std::shared_ptr<Font> font{nullptr};
         float fontScale{1.0f};
+        // Shared with the control blocks of the widgets allocated from it, see ArenaAllocator
+        std::shared_ptr<std::pmr::synchronized_pool_resource> arena{nullptr};
 
         void unFreeze(const std::shared_ptr<Widget> &);
     };
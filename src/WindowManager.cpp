@@ -7,12 +7,25 @@
 module lysa.ui.window_manager;
 
 import lysa;
+import lysa.ui.event;
 #ifdef LUA_BINDINGS
 import lysa.ui.lua;
 #endif
 
 namespace lysa::ui {
 
+#ifdef LYSA_UI_HEADLESS
+    WindowManager::WindowManager(
+        const std::string& defaultFontURI,
+        const float defaultFontScale,
+        const float4& defaultTextColor,
+        const float aspectRatio):
+        renderer{aspectRatio},
+        fontScale{defaultFontScale},
+        textColor{defaultTextColor} {
+        defaultFont = std::make_shared<Font>(defaultFontURI);
+    }
+#else
     WindowManager::WindowManager(
         RenderingWindow& renderingWindow,
         const std::string& defaultFontURI,
@@ -34,6 +47,21 @@ namespace lysa::ui {
             evt.consumed = onInput(std::any_cast<InputEvent>(evt.payload));
         });
     }
+#endif
+
+    float WindowManager::getAspectRatio() const {
+#ifdef LYSA_UI_HEADLESS
+        return renderer.getAspectRatio();
+#else
+        return renderingWindow.getRenderTarget().getAspectRatio();
+#endif
+    }
+
+    void WindowManager::updateMouseCursor() const {
+#ifndef LYSA_UI_HEADLESS
+        renderingWindow.setMouseCursor(currentCursor);
+#endif
+    }
 
     WindowManager::~WindowManager() {
         if (onInputHandler) ctx().events.unsubscribe(onInputHandler);
@@ -45,15 +73,28 @@ namespace lysa::ui {
     }
 
     void WindowManager::drawFrame() {
-        auto lock = std::lock_guard(windowsMutex);
-        for(const auto&window : removedWindows) {
+        // Outside of the lock : the mutations can add or remove windows
+        mutations.drain();
+        // Signals of the previous frame & of the input, before the layout
+        UIEvent::dispatch();
+        flushMouseMotion();
+        {
+            // The windows callbacks are run outside of the lock : they can add or remove windows
+            auto lock = std::lock_guard(windowsMutex);
+            frameRemovedWindows.assign(removedWindows.begin(), removedWindows.end());
+            removedWindows.clear();
+            for (const auto& window : frameRemovedWindows) {
+                windows.remove(window);
+            }
+            frameWindows.assign(windows.begin(), windows.end());
+        }
+        for (const auto& window : frameRemovedWindows) {
             window->_detach();
             if (window->isVisible()) { window->eventHide(); }
             window->eventDestroy(renderer);
-            windows.remove(window);
         }
-        removedWindows.clear();
-        for (auto& window: windows) {
+        frameRemovedWindows.clear();
+        for (auto& window: frameWindows) {
             if (window->_isVisibilityChanged()) {
                 window->_commitVisibility();
                 if (window->isVisible()) {
@@ -64,10 +105,10 @@ namespace lysa::ui {
                 } else {
                     if (focusedWindow == window) {
                         window->eventLostFocus();
-                        if (windows.empty()) {
+                        if (frameWindows.empty()) {
                             focusedWindow = nullptr;
                         } else {
-                            focusedWindow = windows.back();
+                            focusedWindow = frameWindows.back();
                             focusedWindow->eventGotFocus();
                         }
                     }
@@ -75,9 +116,12 @@ namespace lysa::ui {
                 }
             }
         }
-        for (const auto& window: windows) {
+        for (const auto& window: frameWindows) {
+            window->layoutWidgets();
             window->draw();
         }
+        frameWindows.clear();
+        snapshots.publish();
     }
 
     std::shared_ptr<Window> WindowManager::add(const std::shared_ptr<Window> &window) {
@@ -92,9 +136,15 @@ namespace lysa::ui {
     }
 
     void WindowManager::remove(const std::shared_ptr<Window>&window) {
+        auto lock = std::lock_guard(windowsMutex);
         removedWindows.insert(window);
     }
 
+    void WindowManager::setCoalesceMouseMotion(const bool enable) {
+        if (!enable) { flushMouseMotion(); }
+        coalesceMouseMotion = enable;
+    }
+
     bool WindowManager::onInput(const InputEvent &inputEvent) {
         if (inputEvent.type == InputEventType::TEXT_INPUT) {
             const auto &textInputEvent = std::get<InputEventTextInput>(inputEvent.data);
@@ -110,119 +160,153 @@ namespace lysa::ui {
                     return focusedWindow->eventKeyUp(keyInputEvent.key);
                 }
             }
-        } else if ((inputEvent.type == InputEventType::MOUSE_BUTTON)
-                || (inputEvent.type == InputEventType::MOUSE_MOTION)) {
-            if (renderingWindow.isMouseHidden()) {
-                return false;
+        } else if (inputEvent.type == InputEventType::MOUSE_MOTION) {
+            const auto &mouseEvent = std::get<InputEventMouseMotion>(inputEvent.data);
+            if (coalesceMouseMotion) {
+                const auto buttonsState = pendingMouseMotion ? pendingMouseMotion->buttonsState : 0;
+                pendingMouseMotion = mouseEvent;
+                pendingMouseMotion->buttonsState |= buttonsState;
+                return mouseMotionConsumed;
             }
-            const auto scaleX = VECTOR_2D_SCREEN_SIZE / renderingWindow.getRenderTarget().getWidth();
-            const auto scaleY = VECTOR_2D_SCREEN_SIZE / renderingWindow.getRenderTarget().getHeight();
-
-            if (inputEvent.type == InputEventType::MOUSE_MOTION) {
-                auto mouseEvent = std::get<InputEventMouseMotion>(inputEvent.data);
-                const auto x = mouseEvent.position.x * scaleX;
-                const auto y = mouseEvent.position.y * scaleY;
-                const auto resizeDeltaY = scaleY * resizeDelta;
-                if ((resizedWindow != nullptr) && (!removedWindows.contains(resizedWindow))) {
-                    if (resizingWindow) {
-                        Rect rect = resizedWindow->getRect();
-                        if (currentCursor == MouseCursor::RESIZE_H) {
-                            const auto lx = x - rect.x;
-                            if (resizingWindowOriginBorder) {
-                                rect.width = rect.width - lx;
-                                rect.x = x;
-                            } else {
-                                rect.width = lx;
-                            }
-                        } else {
-                            const auto ly = y - rect.y;
-                            if (resizingWindowOriginBorder) {
-                                rect.height = rect.height - ly;
-                                rect.y = y;
-                            } else {
-                                rect.height = ly;
-                            }
-                        }
-                        resizedWindow->setRect(rect);
-                        renderingWindow.setMouseCursor(currentCursor);
-                        return true;
+            return routeMouseMotion(mouseEvent);
+        } else if (inputEvent.type == InputEventType::MOUSE_BUTTON) {
+            // The button transition happens after the buffered motion
+            flushMouseMotion();
+            return routeMouseButton(std::get<InputEventMouseButton>(inputEvent.data));
+        }
+        return false;
+    }
+
+    void WindowManager::flushMouseMotion() {
+        if (!pendingMouseMotion) { return; }
+        const auto mouseEvent = *pendingMouseMotion;
+        pendingMouseMotion.reset();
+        mouseMotionConsumed = routeMouseMotion(mouseEvent);
+    }
+
+    bool WindowManager::getMouseScale(float& scaleX, float& scaleY) const {
+#ifdef LYSA_UI_HEADLESS
+        // No render target, the positions are already in UI units
+        scaleX = 1.0f;
+        scaleY = 1.0f;
+#else
+        if (renderingWindow.isMouseHidden()) {
+            return false;
+        }
+        scaleX = VECTOR_2D_SCREEN_SIZE / renderingWindow.getRenderTarget().getWidth();
+        scaleY = VECTOR_2D_SCREEN_SIZE / renderingWindow.getRenderTarget().getHeight();
+#endif
+        return true;
+    }
+
+    bool WindowManager::routeMouseMotion(const InputEventMouseMotion& mouseEvent) {
+        float scaleX, scaleY;
+        if (!getMouseScale(scaleX, scaleY)) { return false; }
+        const auto x = mouseEvent.position.x * scaleX;
+        const auto y = mouseEvent.position.y * scaleY;
+        const auto resizeDeltaY = scaleY * resizeDelta;
+        if ((resizedWindow != nullptr) && (!removedWindows.contains(resizedWindow))) {
+            if (resizingWindow) {
+                Rect rect = resizedWindow->getRect();
+                if (currentCursor == MouseCursor::RESIZE_H) {
+                    const auto lx = x - rect.x;
+                    if (resizingWindowOriginBorder) {
+                        rect.width = rect.width - lx;
+                        rect.x = x;
+                    } else {
+                        rect.width = lx;
                     }
-                    currentCursor = MouseCursor::ARROW;
-                    resizedWindow = nullptr;
-                    renderingWindow.setMouseCursor(currentCursor);
-                }
-                for (const auto& window: windows) {
-                    if (removedWindows.contains(window)) { continue; }
-                    auto consumed = false;
-                    const float lx = std::ceil(x - window->getRect().x);
-                    const float ly = std::ceil(y - window->getRect().y);
-                    if (window->getRect().contains(x, y)) {
-                        if (enableWindowResizing && window->getWidget().isDrawBackground()) {
-                            if ((window->getResizeableBorders() & Window::RESIZEABLE_RIGHT) &&
-                                (lx >= (window->getRect().width - resizeDelta))) {
-                                currentCursor = MouseCursor::RESIZE_H;
-                                resizedWindow = window;
-                                resizingWindowOriginBorder = false;
-                                } else if ((window->getResizeableBorders() & Window::RESIZEABLE_LEFT) &&
-                                           (lx < resizeDelta)) {
-                                    currentCursor = MouseCursor::RESIZE_H;
-                                    resizedWindow = window;
-                                    resizingWindowOriginBorder = true;
-                                           } else if ((window->getResizeableBorders() & Window::RESIZEABLE_TOP) &&
-                                                      (ly >= static_cast<float>(window->getRect().height - resizeDeltaY))) {
-                                               currentCursor = MouseCursor::RESIZE_V;
-                                               resizedWindow = window;
-                                               resizingWindowOriginBorder = false;
-                                                      } else if ((window->getResizeableBorders() & Window::RESIZEABLE_BOTTOM) &&
-                                                                 (ly < static_cast<float>(resizeDeltaY))) {
-                                                          currentCursor = MouseCursor::RESIZE_V;
-                                                          resizedWindow = window;
-                                                          resizingWindowOriginBorder = true;
-                                                                 }
-                        }
-                        if (resizedWindow != nullptr) {
-                            renderingWindow.setMouseCursor(currentCursor);
-                            return true;
-                        }
-                        consumed |= window->eventMouseMove(mouseEvent.buttonsState, lx, ly);
+                } else {
+                    const auto ly = y - rect.y;
+                    if (resizingWindowOriginBorder) {
+                        rect.height = rect.height - ly;
+                        rect.y = y;
+                    } else {
+                        rect.height = ly;
                     }
-                    if (consumed) { return true; }
                 }
-            } else {
-                auto mouseInputEvent = std::get<InputEventMouseButton>(inputEvent.data);
-                const auto x = mouseInputEvent.position.x * scaleX;
-                const auto y = mouseInputEvent.position.y * scaleY;
-                if ((resizedWindow != nullptr) && (!removedWindows.contains(resizedWindow))) {
-                    if ((!resizingWindow) &&
-                        (mouseInputEvent.button== MouseButton::LEFT) &&
-                        (mouseInputEvent.pressed)) {
-                            resizingWindow = true;
-                        } else if ((mouseInputEvent.button == MouseButton::LEFT) &&
-                                   (!mouseInputEvent.pressed)) {
-                            currentCursor = MouseCursor::ARROW;
-                            resizedWindow = nullptr;
-                            resizingWindow = false;
-                        }
-                    renderingWindow.setMouseCursor(currentCursor);
+                resizedWindow->setRect(rect);
+                updateMouseCursor();
+                return true;
+            }
+            currentCursor = MouseCursor::ARROW;
+            resizedWindow = nullptr;
+            updateMouseCursor();
+        }
+        for (const auto& window: windows) {
+            if (removedWindows.contains(window)) { continue; }
+            auto consumed = false;
+            const float lx = std::ceil(x - window->getRect().x);
+            const float ly = std::ceil(y - window->getRect().y);
+            if (window->getRect().contains(x, y)) {
+                if (enableWindowResizing && window->getWidget().isDrawBackground()) {
+                    if ((window->getResizeableBorders() & Window::RESIZEABLE_RIGHT) &&
+                        (lx >= (window->getRect().width - resizeDelta))) {
+                        currentCursor = MouseCursor::RESIZE_H;
+                        resizedWindow = window;
+                        resizingWindowOriginBorder = false;
+                        } else if ((window->getResizeableBorders() & Window::RESIZEABLE_LEFT) &&
+                                   (lx < resizeDelta)) {
+                            currentCursor = MouseCursor::RESIZE_H;
+                            resizedWindow = window;
+                            resizingWindowOriginBorder = true;
+                                   } else if ((window->getResizeableBorders() & Window::RESIZEABLE_TOP) &&
+                                              (ly >= static_cast<float>(window->getRect().height - resizeDeltaY))) {
+                                       currentCursor = MouseCursor::RESIZE_V;
+                                       resizedWindow = window;
+                                       resizingWindowOriginBorder = false;
+                                              } else if ((window->getResizeableBorders() & Window::RESIZEABLE_BOTTOM) &&
+                                                         (ly < static_cast<float>(resizeDeltaY))) {
+                                                  currentCursor = MouseCursor::RESIZE_V;
+                                                  resizedWindow = window;
+                                                  resizingWindowOriginBorder = true;
+                                                         }
+                }
+                if (resizedWindow != nullptr) {
+                    updateMouseCursor();
                     return true;
                 }
-                for (const auto& window: windows) {
-                    auto consumed = false;
-                    const auto lx = std::ceil(x - window->getRect().x);
-                    const auto ly = std::ceil(y - window->getRect().y);
-                    if (mouseInputEvent.pressed) {
-                        if (window->getRect().contains(x, y)) {
-                            focusedWindow = window;
-                            consumed |= window->eventMouseDown(mouseInputEvent.button, lx, ly);
-                        }
-                    } else {
-                        consumed |= window->eventMouseUp(mouseInputEvent.button, lx, ly);
-                    }
-                    if (consumed) { return true; }
+                consumed |= window->eventMouseMove(mouseEvent.buttonsState, lx, ly);
+            }
+            if (consumed) { return true; }
+        }
+        return false;
+    }
+
+    bool WindowManager::routeMouseButton(const InputEventMouseButton& mouseInputEvent) {
+        float scaleX, scaleY;
+        if (!getMouseScale(scaleX, scaleY)) { return false; }
+        const auto x = mouseInputEvent.position.x * scaleX;
+        const auto y = mouseInputEvent.position.y * scaleY;
+        if ((resizedWindow != nullptr) && (!removedWindows.contains(resizedWindow))) {
+            if ((!resizingWindow) &&
+                (mouseInputEvent.button== MouseButton::LEFT) &&
+                (mouseInputEvent.pressed)) {
+                    resizingWindow = true;
+                } else if ((mouseInputEvent.button == MouseButton::LEFT) &&
+                           (!mouseInputEvent.pressed)) {
+                    currentCursor = MouseCursor::ARROW;
+                    resizedWindow = nullptr;
+                    resizingWindow = false;
+                }
+            updateMouseCursor();
+            return true;
+        }
+        for (const auto& window: windows) {
+            auto consumed = false;
+            const auto lx = std::ceil(x - window->getRect().x);
+            const auto ly = std::ceil(y - window->getRect().y);
+            if (mouseInputEvent.pressed) {
+                if (window->getRect().contains(x, y)) {
+                    focusedWindow = window;
+                    consumed |= window->eventMouseDown(mouseInputEvent.button, lx, ly);
                 }
+            } else {
+                consumed |= window->eventMouseUp(mouseInputEvent.button, lx, ly);
             }
+            if (consumed) { return true; }
         }
         return false;
     }
 
-}
\ No newline at end of file
+}
@@ -11,6 +11,10 @@ import lysa.input_event;
 import lysa.math;
 import lysa.rect;
 import lysa.renderers.vector_2d;
+import lysa.ui.mutation_queue;
+import lysa.ui.renderer;
+import lysa.ui.text_measure_cache;
+import lysa.ui.widget_snapshot;
 import lysa.resources.font;
 import lysa.resources.rendering_window;
 import lysa.ui.window;
@@ -23,9 +27,32 @@ export namespace lysa::ui {
      * The WindowManager must be created as soon as possible to
      * be the first subscriber to receive input event and stop
      * them to be passed to scenes if they are consumed by a widget.
+     *
+     * Threading : the manager, the windows and the widgets are not thread-safe and must only
+     * be used from the UI thread (the thread calling drawFrame() and onInput()), with the
+     * exception of post(). Other threads post their mutations, which are run by the UI thread
+     * at the start of the next drawFrame(), and read the state of the widgets from the snapshots
+     * published at the end of drawFrame(), see getSnapshots().
      */
     class WindowManager {
     public:
+#ifdef LYSA_UI_HEADLESS
+        /**
+         * Creates a manager drawing into an in-memory RecordingRenderer, without rendering window.
+         *
+         * Nothing is subscribed : the application calls drawFrame() and onInput() directly,
+         * with mouse positions given in UI units.
+         * @param defaultFontURI URI of the default font.
+         * @param defaultFontScale Default scale for the font.
+         * @param defaultTextColor Default color for text.
+         * @param aspectRatio Aspect ratio of the simulated render target.
+         */
+        WindowManager(
+            const std::string& defaultFontURI,
+            float defaultFontScale = 1.0f,
+            const float4& defaultTextColor = float4(1.0f, 1.0f, 1.0f, 1.0f),
+            float aspectRatio = 1.0f);
+#else
         /**
          * @param renderingWindow The rendering window to manage UI for.
          * @param defaultFontURI URI of the default font.
@@ -37,6 +64,7 @@ export namespace lysa::ui {
             const std::string& defaultFontURI,
             float defaultFontScale = 1.0f,
             const float4& defaultTextColor = float4(1.0f, 1.0f, 1.0f, 1.0f));
+#endif
 
         virtual ~WindowManager();
 
@@ -63,6 +91,27 @@ export namespace lysa::ui {
          */
         void remove(const std::shared_ptr<Window>& window);
 
+        /**
+         * Posts a mutation of the UI, run on the UI thread at the start of the next frame.
+         * Can be called from any thread without blocking on the UI thread. The mutations
+         * posted by a thread are run in their posting order.
+         */
+        void post(MutationQueue::Mutation mutation) { mutations.post(std::move(mutation)); }
+
+        /**
+         * Posts a mutation of a widget or a window, run on the UI thread at the start of the
+         * next frame. Can be called from any thread. The mutation is not run if the target
+         * has been destroyed in the meantime.
+         */
+        template <typename T, typename F>
+        void post(const std::shared_ptr<T>& target, F&& mutation) {
+            mutations.post([target = std::weak_ptr<T>{target}, mutation = std::forward<F>(mutation)] {
+                if (const auto locked = target.lock()) {
+                    mutation(*locked);
+                }
+            });
+        }
+
         /**
          * Returns the default font loaded at creation.
          */
@@ -91,12 +140,23 @@ export namespace lysa::ui {
         /**
          * Returns the aspect ratio of the managed rendering window.
          */
-        float getAspectRatio() const { return renderingWindow.getRenderTarget().getAspectRatio(); }
+        float getAspectRatio() const;
 
         /**
          * Returns the 2D renderer used by the manager.
          */
-        Vector2DRenderer& getRenderer() { return renderer; }
+        UIRenderer& getRenderer() { return renderer; }
+
+        /**
+         * Returns the cache of the text sizes shared by all the widgets of the managed windows.
+         */
+        TextMeasureCache& getTextMeasureCache() { return textMeasureCache; }
+
+        /**
+         * Returns the snapshots of the watched widgets, published at the end of each frame
+         * for the other threads.
+         */
+        WidgetSnapshots& getSnapshots() { return snapshots; }
 
         /**
          * Returns the resize delta for window resizing.
@@ -108,8 +168,27 @@ export namespace lysa::ui {
          */
         void setEnableWindowResizing(const bool enable) { enableWindowResizing = enable; }
 
+        /**
+         * Enables or disables the coalescing of the mouse motion events.
+         *
+         * When enabled, the motion events are buffered and only the latest position, with the
+         * accumulated buttons state, is routed to the windows : once per frame at the start of
+         * drawFrame(), or before the next mouse button event to keep the button transitions
+         * ordered with the motions. A buffered motion event is reported as consumed if the
+         * last routed one was.
+         */
+        void setCoalesceMouseMotion(bool enable);
+
+        /**
+         * Returns true if the mouse motion events are coalesced, see setCoalesceMouseMotion().
+         */
+        auto isCoalesceMouseMotion() const { return coalesceMouseMotion; }
+
         /**
          * Draws one frame of the UI.
+         *
+         * Runs the posted mutations and routes the buffered mouse motion, if any, then runs a
+         * single layout pass over the invalidated widgets of each visible window and draws them.
          */
         void drawFrame();
 
@@ -122,10 +201,18 @@ export namespace lysa::ui {
 
     private:
         const float resizeDelta{5.0f};
+#ifndef LYSA_UI_HEADLESS
         RenderingWindow& renderingWindow;
-        Vector2DRenderer renderer;
+#endif
+        UIRenderer renderer;
+        TextMeasureCache textMeasureCache;
+        MutationQueue mutations;
+        WidgetSnapshots snapshots;
         std::shared_ptr<Font> defaultFont;
         std::list<std::shared_ptr<Window>> windows;
+        // Copies of `windows` & `removedWindows` taken under the lock, used by drawFrame()
+        std::vector<std::shared_ptr<Window>> frameWindows;
+        std::vector<std::shared_ptr<Window>> frameRemovedWindows;
         std::mutex windowsMutex;
         std::set<std::shared_ptr<Window>> removedWindows{};
         std::shared_ptr<Window> focusedWindow{nullptr};
@@ -136,7 +223,24 @@ export namespace lysa::ui {
         MouseCursor currentCursor{MouseCursor::ARROW};
         float fontScale;
         float4 textColor{1.0f};
-        unique_id onProcessHandler;
-        unique_id onInputHandler;
+        unique_id onProcessHandler{};
+        unique_id onInputHandler{};
+        bool coalesceMouseMotion{false};
+        // Latest buffered motion event, with the accumulated buttons state
+        std::optional<InputEventMouseMotion> pendingMouseMotion;
+        // Result of the last routed motion event
+        bool mouseMotionConsumed{false};
+
+        void updateMouseCursor() const;
+
+        // Scale from the rendering window pixels to UI units, false if the mouse is hidden
+        bool getMouseScale(float& scaleX, float& scaleY) const;
+
+        bool routeMouseMotion(const InputEventMouseMotion& mouseEvent);
+
+        bool routeMouseButton(const InputEventMouseButton& mouseInputEvent);
+
+        // Routes the buffered motion event, if any
+        void flushMouseMotion();
     };
 }
@@ -17,6 +17,32 @@ import lysa.ui;
 
 namespace lysa::ui {
 
+    // Converts a Lua array to a vector in a single call, strings are converted to Text widgets
+    std::vector<std::shared_ptr<Widget>> toWidgets(const luabridge::LuaRef& table) {
+        std::vector<std::shared_ptr<Widget>> widgets;
+        const auto count = table.length();
+        widgets.reserve(count);
+        for (auto i = 1; i <= count; i++) {
+            const auto value = table[i];
+            if (value.isString()) {
+                widgets.push_back(std::make_shared<Text>(value.unsafe_cast<std::string>()));
+            } else {
+                widgets.push_back(value.unsafe_cast<std::shared_ptr<Widget>>());
+            }
+        }
+        return widgets;
+    }
+
+    std::vector<std::shared_ptr<TreeView::Item>> toTreeViewItems(const luabridge::LuaRef& table) {
+        std::vector<std::shared_ptr<TreeView::Item>> items;
+        const auto count = table.length();
+        items.reserve(count);
+        for (auto i = 1; i <= count; i++) {
+            items.push_back(table[i].unsafe_cast<std::shared_ptr<TreeView::Item>>());
+        }
+        return items;
+    }
+
     void LuaBindings::_register(lua_State* L) {
         if (registered) return;
         registered = true;
@@ -77,6 +103,8 @@ namespace lysa::ui {
             .addVariable("SELECTION", Widget::SELECTION)
             .addVariable("PROGRESSBAR", Widget::PROGRESSBAR)
             .addVariable("SCROLLBOX", Widget::SCROLLBOX)
+            .addVariable("TREEVIEWROW", Widget::TREEVIEWROW)
+            .addVariable("TEXTAREA", Widget::TEXTAREA)
         .endNamespace()
 
         .beginNamespace("CheckState")
@@ -138,6 +166,34 @@ namespace lysa::ui {
             .addVariable("OnInsertItem", &UIEvent::OnInsertItem)
             .addVariable("OnRemoveItem", &UIEvent::OnRemoveItem)
             .addVariable("OnSelectItem", &UIEvent::OnSelectItem)
+            .addVariable("OnInsertItems", &UIEvent::OnInsertItems)
+            .addVariable("OnRemoveItems", &UIEvent::OnRemoveItems)
+            .addVariable("ON_CREATE", UIEvent::ON_CREATE)
+            .addVariable("ON_DESTROY", UIEvent::ON_DESTROY)
+            .addVariable("ON_KEY_DOWN", UIEvent::ON_KEY_DOWN)
+            .addVariable("ON_KEY_UP", UIEvent::ON_KEY_UP)
+            .addVariable("ON_MOUSE_DOWN", UIEvent::ON_MOUSE_DOWN)
+            .addVariable("ON_MOUSE_UP", UIEvent::ON_MOUSE_UP)
+            .addVariable("ON_MOUSE_MOVE", UIEvent::ON_MOUSE_MOVE)
+            .addVariable("ON_GOT_FOCUS", UIEvent::ON_GOT_FOCUS)
+            .addVariable("ON_LOST_FOCUS", UIEvent::ON_LOST_FOCUS)
+            .addVariable("ON_SHOW", UIEvent::ON_SHOW)
+            .addVariable("ON_HIDE", UIEvent::ON_HIDE)
+            .addVariable("ON_ENABLE", UIEvent::ON_ENABLE)
+            .addVariable("ON_DISABLE", UIEvent::ON_DISABLE)
+            .addVariable("ON_TEXT_CHANGE", UIEvent::ON_TEXT_CHANGE)
+            .addVariable("ON_TEXT_INPUT", UIEvent::ON_TEXT_INPUT)
+            .addVariable("ON_CLICK", UIEvent::ON_CLICK)
+            .addVariable("ON_STATE_CHANGE", UIEvent::ON_STATE_CHANGE)
+            .addVariable("ON_VALUE_CHANGE", UIEvent::ON_VALUE_CHANGE)
+            .addVariable("ON_RANGE_CHANGE", UIEvent::ON_RANGE_CHANGE)
+            .addVariable("ON_RESIZE", UIEvent::ON_RESIZE)
+            .addVariable("ON_MOVE", UIEvent::ON_MOVE)
+            .addVariable("ON_INSERT_ITEM", UIEvent::ON_INSERT_ITEM)
+            .addVariable("ON_REMOVE_ITEM", UIEvent::ON_REMOVE_ITEM)
+            .addVariable("ON_SELECT_ITEM", UIEvent::ON_SELECT_ITEM)
+            .addVariable("ON_INSERT_ITEMS", UIEvent::ON_INSERT_ITEMS)
+            .addVariable("ON_REMOVE_ITEMS", UIEvent::ON_REMOVE_ITEMS)
         .endNamespace()
 
         .beginClass<Widget>("Widget")
@@ -173,6 +229,8 @@ namespace lysa::ui {
             .addProperty("children_rect", &Widget::getChildrenRect)
             .addProperty("user_data", &Widget::getLuaUserData, &Widget::setLuaUserData)
             .addFunction("refresh", &Widget::refresh)
+            .addFunction("invalidate_paint", &Widget::invalidatePaint)
+            .addFunction("invalidate_layout", &Widget::invalidateLayout)
             .addProperty("group_index", &Widget::getGroupIndex, &Widget::setGroupIndex)
             .addProperty("transparency", &Widget::getTransparency, &Widget::setTransparency)
             .addFunction("resize_children", &Widget::resizeChildren)
@@ -184,6 +242,12 @@ namespace lysa::ui {
             .addProperty("children_offset_x", &Widget::getChildrenOffsetX)
             .addProperty("children_offset_y", &Widget::getChildrenOffsetY)
             .addFunction("set_children_offset", &Widget::setChildrenOffset)
+            .addProperty("clip_children", &Widget::isClipChildren, &Widget::setClipChildren)
+            .addFunction("add_subscription", &Widget::addSubscription)
+            .addFunction("remove_subscription", &Widget::removeSubscription)
+            .addFunction("is_subscribed", &Widget::isSubscribed)
+            .addStaticFunction("set_signal_undeclared", &Widget::setSignalUndeclared)
+            .addStaticFunction("is_signal_undeclared", &Widget::isSignalUndeclared)
             .addFunction("create_text",
                 +[](Widget* self, const int alignment, const std::string& text) -> std::shared_ptr<Text> {
                     return self->create<Text>(static_cast<Alignment>(alignment), text);
@@ -254,6 +318,13 @@ namespace lysa::ui {
                 +[](Widget* self, const std::string& resource, const int alignment, const std::string& text = "") {
                     return self->create<TextEdit>(resource, static_cast<Alignment>(alignment), text);
                 })
+            .addFunction("create_text_area",
+                +[](Widget* self, const int alignment, const std::string& text = "") {
+                    return self->create<TextArea>(static_cast<Alignment>(alignment), text);
+                },
+                +[](Widget* self, const std::string& resource, const int alignment, const std::string& text = "") {
+                    return self->create<TextArea>(resource, static_cast<Alignment>(alignment), text);
+                })
             .addFunction("create_image",
                 +[](Widget* self, const int alignment) -> std::shared_ptr<Image> {
                     return self->create<Image>(static_cast<Alignment>(alignment));
@@ -407,6 +478,22 @@ namespace lysa::ui {
             .addFunction("set_resources", &TextEdit::setResources)
         .endClass()
 
+        .deriveClass<TextArea, Widget>("TextArea")
+            .addConstructor<void(), void(const std::string&)>()
+            .addProperty("is_read_only", &TextArea::isReadOnly, &TextArea::setReadOnly)
+            .addProperty("text", &TextArea::getText, &TextArea::setText)
+            .addProperty("line_count", &TextArea::getLineCount)
+            .addProperty("caret_line", &TextArea::getCaretLine)
+            .addProperty("caret_column", &TextArea::getCaretColumn)
+            .addProperty("caret_position", &TextArea::getCaretPosition)
+            .addProperty("line_height", &TextArea::getLineHeight, &TextArea::setLineHeight)
+            .addFunction("get_line", &TextArea::getLine)
+            .addFunction("insert", &TextArea::insert)
+            .addFunction("erase", &TextArea::erase)
+            .addFunction("set_caret", &TextArea::setCaret)
+            .addFunction("set_resources", &TextArea::setResources)
+        .endClass()
+
         .deriveClass<Image, Widget>("Image")
             .addConstructor<
                 void(),
@@ -446,11 +533,13 @@ namespace lysa::ui {
             .addConstructor<void(), void(float, float, float, float)>()
         .endClass()
 
-        .deriveClass<TreeView::Item, Panel>("TreeViewItem")
+        .beginClass<TreeView::Item>("TreeViewItem")
             .addProperty("item", &TreeView::Item::item)
-            .addProperty("level", &TreeView::Item::level)
+            .addProperty("level", &TreeView::Item::level, false)
             .addProperty("selected", &TreeView::Item::selected)
-            .addProperty("expanded", &TreeView::Item::expanded)
+            .addProperty("expanded", &TreeView::Item::expanded, false)
+            .addProperty("lazy", &TreeView::Item::lazy)
+            .addProperty("loading", &TreeView::Item::loading, false)
         .endClass()
 
         .deriveClass<TreeView, Widget>("TreeView")
@@ -462,7 +551,38 @@ namespace lysa::ui {
                 luabridge::overload<const std::shared_ptr<TreeView::Item>&,
                                     std::shared_ptr<Widget>>(&TreeView::addItem)
             )
+            .addFunction("add_items",
+                +[](TreeView* self, const luabridge::LuaRef& items) {
+                    return self->addItems(toWidgets(items));
+                },
+                +[](TreeView* self, const std::shared_ptr<TreeView::Item>& parent, const luabridge::LuaRef& items) {
+                    return self->addItems(parent, toWidgets(items));
+                })
+            .addFunction("remove_items",
+                +[](TreeView* self, const luabridge::LuaRef& items) {
+                    self->removeItems(toTreeViewItems(items));
+                })
+            .addFunction("replace_all",
+                +[](TreeView* self, const luabridge::LuaRef& items) {
+                    return self->replaceAll(toWidgets(items));
+                })
             .addFunction("expand", &TreeView::expand)
+            .addFunction("collapse", &TreeView::collapse)
+            .addFunction("set_children_provider",
+                +[](TreeView* self, const luabridge::LuaRef& provider) {
+                    if (provider.isNil()) {
+                        self->setChildrenProvider(nullptr);
+                        return;
+                    }
+                    self->setChildrenProvider([provider](const std::shared_ptr<TreeView::Item>& item) {
+                        provider(item);
+                    });
+                })
+            .addFunction("children_loaded", &TreeView::childrenLoaded)
+            .addFunction("set_placeholder_text", &TreeView::setPlaceholderText)
+            .addProperty("visible_count", &TreeView::getVisibleCount)
+            .addProperty("row_height", &TreeView::getRowHeight, &TreeView::setRowHeight)
+            .addProperty("indent", &TreeView::getIndent, &TreeView::setIndent)
         .endClass()
 
         .deriveClass<List, Widget>("List")
@@ -477,6 +597,21 @@ namespace lysa::ui {
                     return self->addItem(item, static_cast<Alignment>(alignment), resource);
                 })
             .addFunction("remove_item", &List::removeItem)
+            .addFunction("add_items",
+                +[](List* self,
+                    const luabridge::LuaRef& items,
+                    const int alignment,
+                    const std::string& resource) -> int32 {
+                    return self->addItems(toWidgets(items), static_cast<Alignment>(alignment), resource);
+                })
+            .addFunction("remove_items", &List::removeItems)
+            .addFunction("replace_all",
+                +[](List* self,
+                    const luabridge::LuaRef& items,
+                    const int alignment,
+                    const std::string& resource) {
+                    self->replaceAll(toWidgets(items), static_cast<Alignment>(alignment), resource);
+                })
             .addFunction("remove_all_items", &List::removeAllItems)
             .addFunction("get_item", &List::getItem)
             .addFunction("select", &List::select)
@@ -522,6 +657,24 @@ namespace lysa::ui {
                 })
             .addFunction("remove_content", &ScrollBox::removeContent)
             .addFunction("remove_all_content", &ScrollBox::removeAllContent)
+            .addFunction("add_contents",
+                +[](ScrollBox* self,
+                    const luabridge::LuaRef& children,
+                    const int alignment,
+                    const std::string& resource) {
+                    self->addContents(toWidgets(children), static_cast<Alignment>(alignment), resource);
+                })
+            .addFunction("remove_contents",
+                +[](ScrollBox* self, const luabridge::LuaRef& children) {
+                    self->removeContents(toWidgets(children));
+                })
+            .addFunction("replace_all_content",
+                +[](ScrollBox* self,
+                    const luabridge::LuaRef& children,
+                    const int alignment,
+                    const std::string& resource) {
+                    self->replaceAllContent(toWidgets(children), static_cast<Alignment>(alignment), resource);
+                })
             .addProperty("inner_box", &ScrollBox::getInnerBox)
         .endClass()
 
@@ -645,6 +798,13 @@ namespace lysa::ui {
                 +[](Window* self, const std::string& resource, const int alignment, const std::string& text = "") -> std::shared_ptr<TextEdit> {
                     return self->create<TextEdit>(resource, static_cast<Alignment>(alignment), text);
                 })
+            .addFunction("create_text_area",
+                +[](Window* self, const int alignment, const std::string& text = "") -> std::shared_ptr<TextArea> {
+                    return self->create<TextArea>(static_cast<Alignment>(alignment), text);
+                },
+                +[](Window* self, const std::string& resource, const int alignment, const std::string& text = "") -> std::shared_ptr<TextArea> {
+                    return self->create<TextArea>(resource, static_cast<Alignment>(alignment), text);
+                })
             .addFunction("create_image",
                 +[](Window* self, const int alignment) -> std::shared_ptr<Image> {
                     return self->create<Image>(static_cast<Alignment>(alignment));
@@ -720,6 +880,17 @@ namespace lysa::ui {
                 })
         .endClass()
 
+        .beginClass<TextMeasureCache>("TextMeasureCache")
+            .addProperty("size", &TextMeasureCache::size)
+            .addProperty("capacity", &TextMeasureCache::getCapacity, &TextMeasureCache::setCapacity)
+            .addProperty("hits", +[](const TextMeasureCache* self) { return self->getStats().hits; })
+            .addProperty("misses", +[](const TextMeasureCache* self) { return self->getStats().misses; })
+            .addProperty("evictions", +[](const TextMeasureCache* self) { return self->getStats().evictions; })
+            .addProperty("hit_rate", +[](const TextMeasureCache* self) { return self->getStats().getHitRate(); })
+            .addFunction("reset_stats", &TextMeasureCache::resetStats)
+            .addFunction("clear", &TextMeasureCache::clear)
+        .endClass()
+
         .beginClass<WindowManager>("WindowManager")
             .addConstructor<void(RenderingWindow&, const std::string&, float, const float4&)>()
             .addFunction("create",
@@ -733,7 +904,12 @@ namespace lysa::ui {
             .addProperty("default_text_color", &WindowManager::getDefaultTextColor, &WindowManager::setDefaultTextColor)
             .addProperty("aspect_ratio", &WindowManager::getAspectRatio)
             .addProperty("resize_delta", &WindowManager::getResizeDelta)
+            .addProperty("coalesce_mouse_motion", &WindowManager::isCoalesceMouseMotion, &WindowManager::setCoalesceMouseMotion)
             .addFunction("set_enable_window_resizing", &WindowManager::setEnableWindowResizing)
+            .addProperty("text_measure_cache",
+                +[](WindowManager* self) -> TextMeasureCache& {
+                    return self->getTextMeasureCache();
+                })
         .endClass()
 
         .endNamespace().endNamespace();
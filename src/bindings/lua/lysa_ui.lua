@@ -47,6 +47,8 @@
 ---@field SELECTION integer A selection highlight rectangle used inside a ListBox.
 ---@field PROGRESSBAR integer A rectangular progress bar widget.
 ---@field SCROLLBOX integer A scrollable container with horizontal and vertical scroll bars.
+---@field TREEVIEWROW integer A row of a TreeView, with its indentation and expand handle drawn by the style (internal).
+---@field TEXTAREA integer An editable multi-line text field.
 
 ---@class lysa.ui.CheckState Check/toggle state constants for CheckWidget and ToggleButton.
 ---@field UNCHECK integer Unchecked / OFF state.
@@ -90,7 +92,7 @@
 ---@field OnHide string Fired when the widget's visibility changes to hidden.
 ---@field OnEnable string Fired when the widget transitions to the enabled state.
 ---@field OnDisable string Fired when the widget transitions to the disabled state.
----@field OnTextChange string Fired when the widget's text content changes (TextEdit, Text).
+---@field OnTextChange string Fired when the widget's text content changes (TextEdit, TextArea, Text).
 ---@field OnTextInput string Fired on each character input from the user (TextEdit).
 ---@field OnClick string Fired when a Button or ToggleButton is clicked.
 ---@field OnStateChange string Fired when a CheckWidget changes state (checked ↔ unchecked).
@@ -101,6 +103,34 @@
 ---@field OnInsertItem string Fired when an item is inserted into a List (ListBox, etc.).
 ---@field OnRemoveItem string Fired when an item is removed from a List.
 ---@field OnSelectItem string Fired when the selected item of a List changes.
+---@field OnInsertItems string Fired once when a range of items is inserted into a List by add_items or replace_all.
+---@field OnRemoveItems string Fired once when a range of items is removed from a List by remove_items, remove_all_items or replace_all.
+---@field ON_CREATE integer Id of OnCreate, for Widget:add_subscription.
+---@field ON_DESTROY integer Id of OnDestroy, for Widget:add_subscription.
+---@field ON_KEY_DOWN integer Id of OnKeyDown, for Widget:add_subscription.
+---@field ON_KEY_UP integer Id of OnKeyUp, for Widget:add_subscription.
+---@field ON_MOUSE_DOWN integer Id of OnMouseDown, for Widget:add_subscription.
+---@field ON_MOUSE_UP integer Id of OnMouseUp, for Widget:add_subscription.
+---@field ON_MOUSE_MOVE integer Id of OnMouseMove, for Widget:add_subscription.
+---@field ON_GOT_FOCUS integer Id of OnGotFocus, for Widget:add_subscription.
+---@field ON_LOST_FOCUS integer Id of OnLostFocus, for Widget:add_subscription.
+---@field ON_SHOW integer Id of OnShow, for Widget:add_subscription.
+---@field ON_HIDE integer Id of OnHide, for Widget:add_subscription.
+---@field ON_ENABLE integer Id of OnEnable, for Widget:add_subscription.
+---@field ON_DISABLE integer Id of OnDisable, for Widget:add_subscription.
+---@field ON_TEXT_CHANGE integer Id of OnTextChange, for Widget:add_subscription.
+---@field ON_TEXT_INPUT integer Id of OnTextInput, for Widget:add_subscription.
+---@field ON_CLICK integer Id of OnClick, for Widget:add_subscription.
+---@field ON_STATE_CHANGE integer Id of OnStateChange, for Widget:add_subscription.
+---@field ON_VALUE_CHANGE integer Id of OnValueChange, for Widget:add_subscription.
+---@field ON_RANGE_CHANGE integer Id of OnRangeChange, for Widget:add_subscription.
+---@field ON_RESIZE integer Id of OnResize, for Widget:add_subscription.
+---@field ON_MOVE integer Id of OnMove, for Widget:add_subscription.
+---@field ON_INSERT_ITEM integer Id of OnInsertItem, for Widget:add_subscription.
+---@field ON_REMOVE_ITEM integer Id of OnRemoveItem, for Widget:add_subscription.
+---@field ON_SELECT_ITEM integer Id of OnSelectItem, for Widget:add_subscription.
+---@field ON_INSERT_ITEMS integer Id of OnInsertItems, for Widget:add_subscription.
+---@field ON_REMOVE_ITEMS integer Id of OnRemoveItems, for Widget:add_subscription.
 
 ---@class lysa.ui.Widget The base class for all UI widgets. Provides layout, input handling, and child management.
 ---@field id integer The unique ID
@@ -131,16 +161,24 @@
 ---@field pointed boolean True if the mouse cursor is currently over this widget. (read-only)
 ---@field freezed boolean True if the widget ignores all input events without being visually disabled.
 ---@field overlapping boolean True if this widget visually overlaps one or more siblings. (read-only)
----@field children_rect lysa.Rect The smallest Rect enclosing all direct children. (read-only)
+---@field children_rect lysa.Rect The smallest Rect enclosing the widget and all its descendants, including overlapping popups. (read-only)
 ---@field group_index integer User-defined integer tag used to identify widgets within a logical group.
 ---@field transparency number Global alpha multiplier for the widget (0.0 = fully transparent, 1.0 = opaque).
----@field refresh fun(self:lysa.ui.Widget):nil Forces a full redraw of the widget on the next frame.
----@field resize_children fun(self:lysa.ui.Widget):nil Triggers a layout pass that repositions and resizes all direct children according to their alignment.
+---@field refresh fun(self:lysa.ui.Widget):nil Forces a full redraw of the widget and all its descendants on the next frame.
+---@field invalidate_paint fun(self:lysa.ui.Widget):nil Redraws only this widget on the next frame, leaving its descendants untouched.
+---@field invalidate_layout fun(self:lysa.ui.Widget):nil Requests a layout of the widget children, done once before the next frame is drawn.
+---@field resize_children fun(self:lysa.ui.Widget):nil Immediately repositions and resizes all direct children according to their alignment.
 ---@field set_focus fun(self:lysa.ui.Widget, focus:boolean|nil):lysa.ui.Widget Requests keyboard focus for this widget (pass nil or true to acquire, false to release). Returns the widget itself.
 ---@field consume_mouse_event boolean When true, mouse events are consumed by this widget and not propagated to its parent.
----@field children_offset_x number Horizontal scroll offset subtracted from child positions during layout (read-only; use set_children_offset to change).
----@field children_offset_y number Vertical scroll offset subtracted from child positions during layout (read-only; use set_children_offset to change).
----@field set_children_offset fun(self:lysa.ui.Widget, x:number, y:number):nil Sets the scroll offset applied to children during layout, enabling scrollable content.
+---@field children_offset_x number Horizontal scroll offset subtracted from the drawn child positions (read-only; use set_children_offset to change).
+---@field children_offset_y number Vertical scroll offset subtracted from the drawn child positions (read-only; use set_children_offset to change).
+---@field set_children_offset fun(self:lysa.ui.Widget, x:number, y:number):nil Sets the scroll offset applied to children when drawing and hit-testing, without relayout, enabling scrollable content.
+---@field clip_children boolean When true, the children are clipped to the client area : the ones entirely outside are not drawn and do not receive mouse events.
+---@field add_subscription fun(self:lysa.ui.Widget, event:integer):nil Declares a handler for a signal (a UIEvent.ON_* id). The lifecycle & input signals of a widget are only fired when a handler is declared, unless set_signal_undeclared is enabled.
+---@field remove_subscription fun(self:lysa.ui.Widget, event:integer):nil Removes a handler declared with add_subscription.
+---@field is_subscribed fun(self:lysa.ui.Widget, event:integer):boolean Returns true if at least one handler is declared for a signal (a UIEvent.ON_* id).
+---@field set_signal_undeclared fun(signal:boolean):nil Static. Pushes the lifecycle & input signals of all the widgets, with or without a declared handler (default true). Deprecated : declare the handlers with add_subscription then disable it, it will be disabled by default in the next release.
+---@field is_signal_undeclared fun():boolean Static. Returns true if the lifecycle & input signals are pushed without a declared handler.
 ---@field create_text fun(self:lysa.ui.Widget, alignment:lysa.ui.Alignment, text:string):lysa.ui.Text Creates and adds a Text child widget with the given alignment and initial text. @overload
 ---@field create_text fun(self:lysa.ui.Widget, resource:string, alignment:lysa.ui.Alignment, text:string):lysa.ui.Text Creates and adds a Text child widget, loading its style from a resource string. @overload
 ---@field create_panel fun(self:lysa.ui.Widget, alignment:lysa.ui.Alignment):lysa.ui.Panel Creates and adds a Panel child widget with the given alignment. @overload
@@ -161,6 +199,8 @@
 ---@field create_frame fun(self:lysa.ui.Widget, resource:string, alignment:lysa.ui.Alignment, title:string):lysa.ui.Frame Creates and adds a Frame child widget, loading its style from a resource string. @overload
 ---@field create_text_edit fun(self:lysa.ui.Widget, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextEdit Creates and adds a TextEdit child widget with the given alignment and optional initial text. @overload
 ---@field create_text_edit fun(self:lysa.ui.Widget, resource:string, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextEdit Creates and adds a TextEdit child widget, loading its style from a resource string. @overload
+---@field create_text_area fun(self:lysa.ui.Widget, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextArea Creates and adds a TextArea child widget with the given alignment and optional initial text. @overload
+---@field create_text_area fun(self:lysa.ui.Widget, resource:string, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextArea Creates and adds a TextArea child widget, loading its style from a resource string. @overload
 ---@field create_image fun(self:lysa.ui.Widget, alignment:lysa.ui.Alignment):lysa.ui.Image Creates and adds an Image child widget with the given alignment. @overload
 ---@field create_image fun(self:lysa.ui.Widget, resource:string, alignment:lysa.ui.Alignment):lysa.ui.Image Creates and adds an Image child widget, loading its style from a resource string. @overload
 ---@field create_image fun(self:lysa.ui.Widget, resource:string, alignment:lysa.ui.Alignment, autoresize:boolean, fixedsize:boolean):lysa.ui.Image Creates and adds an Image child widget with auto-resize and fixed-size options. @overload
@@ -223,6 +263,20 @@
 ---@field displayed_text string The substring of text currently visible inside the widget bounds. (read-only)
 ---@field set_resources fun(self:lysa.ui.TextEdit, resource:string):nil Reloads the visual style of this TextEdit from the given resource string.
 
+---@class lysa.ui.TextArea : lysa.ui.Widget A multi-line editable text field. Only the visible lines are displayed. Fires OnTextChange (without the text) and OnTextInput events.
+---@field is_read_only boolean True if the field is read-only; the user can view but not edit the text.
+---@field text string The whole text, lines separated by "\n".
+---@field line_count integer Number of lines of the text. (read-only)
+---@field caret_line integer Line of the caret, starting at 0. (read-only)
+---@field caret_column integer Column of the caret in its line, starting at 0. (read-only)
+---@field caret_position integer Character index of the caret in the text. (read-only)
+---@field line_height number Height of each line, in UI units. Defaults to the height of a line of text.
+---@field get_line fun(self:lysa.ui.TextArea, line:integer):string Returns a line of the text, without the line break.
+---@field insert fun(self:lysa.ui.TextArea, position:integer, text:string):nil Inserts text at a character index.
+---@field erase fun(self:lysa.ui.TextArea, position:integer, count:integer):nil Removes count characters starting at a character index.
+---@field set_caret fun(self:lysa.ui.TextArea, line:integer, column:integer):nil Moves the caret, scrolling to make it visible.
+---@field set_resources fun(self:lysa.ui.TextArea, resBox:string, resScroll:string):nil Sets the resources of the background box and of the scroll bar.
+
 ---@class lysa.ui.Image : lysa.ui.Widget A widget that displays a GPU image with an optional color tint.
 ---@field set_auto_size fun(self:lysa.ui.Image, autoSize:boolean):nil When true, the widget automatically resizes itself to match the displayed image's pixel dimensions.
 ---@field color lysa.float4 RGBA color tint multiplied with the image pixels (default white = no tint).
@@ -244,25 +298,40 @@
 
 ---@class lysa.ui.HScrollBar : lysa.ui.ScrollBar A horizontal scroll bar widget.
 
----@class lysa.ui.TreeViewItem : lysa.ui.Panel A single row in a TreeView, which can contain a child widget and be expanded or collapsed.
+---@class lysa.ui.TreeViewItem A node of a TreeView, displayed in a row with its widget while on screen, which can be expanded or collapsed.
 ---@field item lysa.ui.Widget The widget rendered as the visible content of this tree row.
----@field level integer Depth of this item in the tree hierarchy (root items have level 0).
+---@field level integer Depth of this item in the tree hierarchy (root items have level 0). (read-only)
 ---@field selected boolean True if this item is currently selected.
----@field expanded boolean True if this item's children are currently visible.
+---@field expanded boolean True if this item's children are currently visible. Use TreeView:expand() and TreeView:collapse() to change it. (read-only)
+---@field lazy boolean True if the children of this item are requested from the children provider on first expand. Set to false for leaves.
+---@field loading boolean True while waiting for TreeView:children_loaded() after a children request. (read-only)
 
 ---@class lysa.ui.TreeView : lysa.ui.Widget A hierarchical list widget that displays items in an expandable/collapsible tree structure.
 ---@field set_resources fun(self:lysa.ui.TreeView, resBox:string, resScroll:string, resHandle:string):nil Reloads the visual style: resBox = row style, resScroll = scroll bar style, resHandle = expand/collapse handle style.
 ---@field remove_all_items fun(self:lysa.ui.TreeView):nil Removes and destroys all items from the tree.
 ---@field add_item fun(self:lysa.ui.TreeView, parent_or_widget:lysa.ui.TreeViewItem|lysa.ui.Widget, widget:lysa.ui.Widget|nil):lysa.ui.TreeViewItem Adds an item to the tree. Pass only a widget to add a root-level item; pass a TreeViewItem and a widget to add a child under that item.
----@field expand fun(self:lysa.ui.TreeView, item:lysa.ui.Widget):nil Programmatically expands the tree item associated with the given content widget.
-
----@class lysa.ui.List : lysa.ui.Widget Base class for all list-of-widgets widgets. Fires OnInsertItem, OnRemoveItem and OnSelectItem events.
+---@field add_items fun(self:lysa.ui.TreeView, parent_or_items:lysa.ui.TreeViewItem|(lysa.ui.Widget|string)[], items:(lysa.ui.Widget|string)[]|nil):lysa.ui.TreeViewItem[] Adds all the widgets of an array as items in a single call, strings are added as Text widgets. Pass only the array to add root-level items; pass a TreeViewItem and the array to add children under that item.
+---@field remove_items fun(self:lysa.ui.TreeView, items:lysa.ui.TreeViewItem[]):nil Removes all the items of an array, with their descendants, in a single call.
+---@field replace_all fun(self:lysa.ui.TreeView, items:(lysa.ui.Widget|string)[]):lysa.ui.TreeViewItem[] Replaces all the items of the tree by root-level items created from an array.
+---@field expand fun(self:lysa.ui.TreeView, item:lysa.ui.TreeViewItem):nil Expands an item, displaying its children. Clicking the +/- handle of a row toggles it too.
+---@field collapse fun(self:lysa.ui.TreeView, item:lysa.ui.TreeViewItem):nil Collapses an item, hiding all its descendants.
+---@field set_children_provider fun(self:lysa.ui.TreeView, provider:fun(item:lysa.ui.TreeViewItem)|nil):nil Sets the function called the first time a lazy item is expanded. Items added while a provider is set are lazy. The provider adds the children with add_items() then calls children_loaded(), immediately or later.
+---@field children_loaded fun(self:lysa.ui.TreeView, item:lysa.ui.TreeViewItem):nil Signals that all the children of a lazy item have been added, removing the placeholder child displayed while loading.
+---@field set_placeholder_text fun(self:lysa.ui.TreeView, text:string):nil Changes the text of the placeholder child displayed while loading children (defaults to "...").
+---@field visible_count integer Number of items whose ancestors are all expanded. (read-only)
+---@field row_height number Height of the rows in UI units, defaults to the height of a line of text. Only the rows on screen get a widget.
+---@field indent number Indentation of each level of the tree in UI units. The indentation and the +/- handle are drawn by the style, without widgets.
+
+---@class lysa.ui.List : lysa.ui.Widget Base class for all list-of-widgets widgets. Fires OnInsertItem, OnRemoveItem, OnInsertItems, OnRemoveItems and OnSelectItem events.
 ---@field NO_SELECTION integer Sentinel value returned by selected_index when nothing is selected.
 ---@field count integer Number of items currently in the list. (read-only)
 ---@field selected_index integer Index (0-based) of the selected item, or NO_SELECTION if nothing is selected. (read-only)
 ---@field selected_item lysa.ui.Widget|nil The currently selected widget, or nil. (read-only)
 ---@field add_item fun(self:lysa.ui.List, item:lysa.ui.Widget, alignment:integer, resource:string):integer Adds a widget at the end of the list and returns its 0-based index.
 ---@field remove_item fun(self:lysa.ui.List, index:integer):nil Removes the item at the given 0-based index.
+---@field add_items fun(self:lysa.ui.List, items:(lysa.ui.Widget|string)[], alignment:integer, resource:string):integer Adds all the widgets of an array at the end of the list in a single call, strings are added as Text widgets. Returns the 0-based index of the first added item.
+---@field remove_items fun(self:lysa.ui.List, index:integer, count:integer):nil Removes `count` items starting at the given 0-based index.
+---@field replace_all fun(self:lysa.ui.List, items:(lysa.ui.Widget|string)[], alignment:integer, resource:string):nil Replaces all the items of the list by the widgets of an array.
 ---@field remove_all_items fun(self:lysa.ui.List):nil Removes all items from the list.
 ---@field get_item fun(self:lysa.ui.List, index:integer):lysa.ui.Widget Returns the widget at the given 0-based index.
 ---@field select fun(self:lysa.ui.List, index:integer):nil Selects the item at the given index; pass NO_SELECTION to clear the selection.
@@ -287,6 +356,9 @@
 ---@field add_content fun(self:lysa.ui.ScrollBox, child:lysa.ui.Widget, alignment:integer, resource:string):lysa.ui.Widget Adds a child widget to the scrollable inner box.
 ---@field remove_content fun(self:lysa.ui.ScrollBox, child:lysa.ui.Widget):nil Removes a child widget from the inner box.
 ---@field remove_all_content fun(self:lysa.ui.ScrollBox):nil Removes all children from the inner box.
+---@field add_contents fun(self:lysa.ui.ScrollBox, children:(lysa.ui.Widget|string)[], alignment:integer, resource:string):nil Adds all the widgets of an array to the inner box in a single call, strings are added as Text widgets.
+---@field remove_contents fun(self:lysa.ui.ScrollBox, children:lysa.ui.Widget[]):nil Removes all the widgets of an array from the inner box.
+---@field replace_all_content fun(self:lysa.ui.ScrollBox, children:(lysa.ui.Widget|string)[], alignment:integer, resource:string):nil Replaces all the children of the inner box by the widgets of an array.
 ---@field inner_box lysa.ui.Box The scrollable inner box containing the added content widgets. (read-only)
 
 ---@class lysa.ui.Window A UI window that owns a root Widget hierarchy and is managed by the WindowManager.
@@ -339,6 +411,8 @@
 ---@field create_frame fun(self:lysa.ui.Window, resource:string, alignment:lysa.ui.Alignment, title:string):lysa.ui.Frame Creates and adds a Frame widget with the given title, loading its style from a resource string. @overload
 ---@field create_text_edit fun(self:lysa.ui.Window, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextEdit Creates and adds a TextEdit widget with optional initial text. @overload
 ---@field create_text_edit fun(self:lysa.ui.Window, resource:string, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextEdit Creates and adds a TextEdit widget, loading its style from a resource string. @overload
+---@field create_text_area fun(self:lysa.ui.Window, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextArea Creates and adds a TextArea widget with optional initial text. @overload
+---@field create_text_area fun(self:lysa.ui.Window, resource:string, alignment:lysa.ui.Alignment, text:string|nil):lysa.ui.TextArea Creates and adds a TextArea widget, loading its style from a resource string. @overload
 ---@field create_image fun(self:lysa.ui.Window, alignment:lysa.ui.Alignment):lysa.ui.Image Creates and adds an Image widget. @overload
 ---@field create_image fun(self:lysa.ui.Window, resource:string, alignment:lysa.ui.Alignment):lysa.ui.Image Creates and adds an Image widget, loading its style from a resource string. @overload
 ---@field create_image fun(self:lysa.ui.Window, resource:string, alignment:lysa.ui.Alignment, autoresize:boolean, fixedsize:boolean):lysa.ui.Image Creates and adds an Image widget with auto-resize and fixed-size options. @overload
@@ -361,6 +435,16 @@
 ---@field create_scroll_box fun(self:lysa.ui.Window, alignment:lysa.ui.Alignment):lysa.ui.ScrollBox Creates and adds a ScrollBox widget. @overload
 ---@field create_scroll_box fun(self:lysa.ui.Window, resource:string, alignment:lysa.ui.Alignment):lysa.ui.ScrollBox Creates and adds a ScrollBox widget, loading its style from a resource string. @overload
 
+---@class lysa.ui.TextMeasureCache Least recently used cache of the text sizes measured by the widgets, keyed on font, font scale and text.
+---@field size integer Number of cached sizes. (read-only)
+---@field capacity integer Maximum number of cached sizes, the least recently used ones are evicted first.
+---@field hits integer Number of sizes found in the cache since the last reset_stats(). (read-only)
+---@field misses integer Number of sizes measured with the font since the last reset_stats(). (read-only)
+---@field evictions integer Number of sizes evicted since the last reset_stats(). (read-only)
+---@field hit_rate number Ratio of the lookups found in the cache, between 0 and 1. (read-only)
+---@field reset_stats fun(self:lysa.ui.TextMeasureCache):nil Resets the hits, misses and evictions counters.
+---@field clear fun(self:lysa.ui.TextMeasureCache):nil Removes all the cached sizes.
+
 ---@class lysa.ui.WindowManager The central manager for all UI windows attached to a rendering target.
 ---@field create fun(self:lysa.ui.WindowManager, rect:lysa.Rect):lysa.ui.Window Creates and registers a new UI window with the given position and size.
 ---@field add fun(self:lysa.ui.WindowManager, window:lysa.ui.Window):lysa.ui.Window Registers an existing UI window with this manager so it receives update and render calls.
@@ -371,6 +455,8 @@
 ---@field aspect_ratio number The aspect ratio of the rendering window this manager is attached to. (read-only)
 ---@field resize_delta number Pixel distance from a window border within which a drag starts a resize operation (default 5.0). (read-only)
 ---@field set_enable_window_resizing fun(self:lysa.ui.WindowManager, enable:boolean):nil Globally enables or disables user-driven window resizing by dragging borders.
+---@field coalesce_mouse_motion boolean When true, only the latest mouse motion (with the accumulated buttons state) is routed, once per frame or before the next button event.
+---@field text_measure_cache lysa.ui.TextMeasureCache The text sizes cache shared by all the managed windows. (read-only)
 
 ---@class lysa.ui The lysa.ui sub-module — immediate-mode UI widgets and window management.
 ---@field Alignment lysa.ui.Alignment Widget placement alignment constants.
@@ -395,6 +481,7 @@
 ---@field Frame lysa.ui.Frame Titled bordered panel widget type.
 ---@field Text lysa.ui.Text Read-only text label widget type.
 ---@field TextEdit lysa.ui.TextEdit Editable text input field widget type.
+---@field TextArea lysa.ui.TextArea Editable multi-line text field widget type.
 ---@field Image lysa.ui.Image GPU image display widget type.
 ---@field ValueSelect lysa.ui.ValueSelect Base type for numeric value selection widgets.
 ---@field ScrollBar lysa.ui.ScrollBar Base scroll bar widget type.
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2026-present Henri Michelon
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+*/
+import std;
+import lysa;
+import lysa.ui;
+
+//
+// Headless regression tests of the UI widget trees, drawn into the RecordingRenderer,
+// and of the data structures & queues used by the widgets.
+//
+// Usage: lysa_ui_tests [--font <uri>]
+//
+
+namespace lysa::ui::tests {
+
+    class Tests {
+    public:
+        explicit Tests(WindowManager& windowManager) : windowManager{windowManager} {}
+
+        // Rows created by the layout of a virtual ListBox are laid out & drawn by the first frame
+        void virtualListBoxFirstFrame() {
+            class Model : public ListBox::Model {
+            public:
+                std::vector<std::shared_ptr<Text>> rows;
+                int32 getRowCount() const override { return 1000; }
+                float getRowHeight() const override { return 20.0f; }
+                std::shared_ptr<Widget> createRow() override {
+                    rows.push_back(std::make_shared<Text>());
+                    return rows.back();
+                }
+                void bindRow(Widget& row, const int32 index) override {
+                    static_cast<Text&>(row).setText(std::format("Row {}", index));
+                }
+            };
+            const auto window = windowManager.create(Rect{0.0f, 0.0f, 1000.0f, 1000.0f});
+            const auto list = window->create<ListBox>(Alignment::FILL);
+            const auto model = std::make_shared<Model>();
+            list->setModel(model);
+            windowManager.drawFrame();
+            check("virtual_list_box_first_frame: rows created", !model->rows.empty());
+            for (const auto& row : model->rows) {
+                if (!row->isVisible()) { continue; }
+                const auto& bounds = row->getChildrenRect();
+                check("virtual_list_box_first_frame: " + row->getText() + " laid out",
+                      (bounds.width > 0.0f) && (bounds.height > 0.0f));
+            }
+            check("virtual_list_box_first_frame: Row 0 drawn", isTextDrawn("Row 0"));
+            window->close();
+            windowManager.drawFrame();
+        }
+
+        // Prefix sums & row lookups of BasicPrefixSums match a naive sum after random edits
+        void prefixSums() {
+            std::mt19937 random{42};
+            BasicPrefixSums<int32> sums;
+            std::vector<int32> expected;
+            // Uniform rows first : the O(1) lookups
+            for (auto i = 0; i < 100; i++) {
+                sums.push_back(5);
+                expected.push_back(5);
+            }
+            checkPrefixSums("prefix_sums: uniform", sums, expected);
+            for (auto i = 0; i < 500; i++) {
+                const auto value = static_cast<int32>(random() % 20) + 1;
+                switch (random() % 4) {
+                case 0:
+                    sums.push_back(value);
+                    expected.push_back(value);
+                    break;
+                case 1: {
+                    if (expected.empty()) { break; }
+                    const auto index = static_cast<int32>(random() % expected.size());
+                    sums.set(index, value);
+                    expected[index] = value;
+                    break;
+                }
+                case 2: {
+                    const auto index = static_cast<int32>(random() % (expected.size() + 1));
+                    const std::vector inserted{value, value + 1, value + 2};
+                    sums.insert(index, inserted);
+                    expected.insert(expected.begin() + index, inserted.begin(), inserted.end());
+                    break;
+                }
+                default: {
+                    if (expected.empty()) { break; }
+                    const auto index = static_cast<int32>(random() % expected.size());
+                    const auto count = std::min(static_cast<int32>(random() % 3) + 1, static_cast<int32>(expected.size()) - index);
+                    sums.erase(index, count);
+                    expected.erase(expected.begin() + index, expected.begin() + index + count);
+                    break;
+                }
+                }
+            }
+            checkPrefixSums("prefix_sums: random edits", sums, expected);
+            sums.clear();
+            check("prefix_sums: clear", sums.empty() && (sums.total() == 0) && (sums.find(10) == 0));
+        }
+
+        // Edits of a GapBuffer, moving the gap around, match the same edits of a std::string
+        void gapBuffer() {
+            std::mt19937 random{42};
+            GapBuffer buffer{"Hello world"};
+            std::string expected{"Hello world"};
+            for (auto i = 0; i < 2000; i++) {
+                const auto index = random() % (expected.size() + 1);
+                if (((random() % 3) != 0) || expected.empty()) {
+                    const auto text = std::string(random() % 8 + 1, static_cast<char>('a' + random() % 26));
+                    buffer.insert(index, text);
+                    expected.insert(index, text);
+                } else {
+                    const auto count = std::min<size_t>(random() % 5 + 1, expected.size() - index);
+                    buffer.erase(index, count);
+                    expected.erase(index, count);
+                }
+            }
+            check("gap_buffer: size", buffer.size() == expected.size());
+            check("gap_buffer: content", buffer.str() == expected);
+            check("gap_buffer: substr", buffer.substr(expected.size() / 3, 20) == expected.substr(expected.size() / 3, 20));
+            buffer.assign("abc");
+            check("gap_buffer: assign", buffer.str() == "abc");
+        }
+
+        // Lines & edits of a Rope spanning several chunks match the same edits of a std::string
+        void rope() {
+            std::string expected;
+            for (auto i = 0; i < 500; i++) {
+                expected += std::format("line {}\n", i);
+            }
+            Rope text{expected};
+            check("rope: size", text.size() == expected.size());
+            check("rope: line count", text.getLineCount() == 501);
+            check("rope: get line", text.getLine(123) == "line 123");
+            check("rope: line at", text.getLineAt(text.getLineStart(300) + 2) == 300);
+            check("rope: last line", text.getLineLength(500) == 0);
+
+            std::mt19937 random{42};
+            for (auto i = 0; i < 1000; i++) {
+                const auto position = random() % (expected.size() + 1);
+                if (((random() % 3) != 0) || expected.empty()) {
+                    const auto inserted = (random() % 4) == 0 ? std::string{"new\nline"} : std::string(random() % 50 + 1, 'x');
+                    text.insert(position, inserted);
+                    expected.insert(position, inserted);
+                } else {
+                    // Up to several chunks
+                    const auto count = std::min<size_t>(random() % (Rope::CHUNK_SIZE * 2) + 1, expected.size() - position);
+                    text.erase(position, count);
+                    expected.erase(position, count);
+                }
+            }
+            check("rope: content after edits", text.str() == expected);
+            check("rope: line count after edits",
+                  text.getLineCount() == static_cast<size_t>(std::ranges::count(expected, '\n')) + 1);
+            auto lineStart = size_t{0};
+            auto linesMatch = true;
+            for (size_t line = 0; line < text.getLineCount(); line++) {
+                const auto lineEnd = std::min(expected.find('\n', lineStart), expected.size());
+                linesMatch &= (text.getLineStart(line) == lineStart) &&
+                               (text.getLine(line) == expected.substr(lineStart, lineEnd - lineStart)) &&
+                               (text.getLineAt(lineStart) == line);
+                lineStart = lineEnd + 1;
+            }
+            check("rope: lines after edits", linesMatch);
+        }
+
+        // The least recently used sizes are evicted when the cache is full
+        void textMeasureCacheEviction() {
+            const auto& font = windowManager.getDefaultFont();
+            TextMeasureCache cache{2};
+            float width, height;
+            cache.getSize(font, 1.0f, "a", width, height);
+            cache.getSize(font, 1.0f, "b", width, height);
+            // "a" is now more recently used than "b"
+            cache.getSize(font, 1.0f, "a", width, height);
+            cache.getSize(font, 1.0f, "c", width, height);
+            check("text_measure_cache: capacity", cache.size() == 2);
+            check("text_measure_cache: one eviction", cache.getStats().evictions == 1);
+            cache.resetStats();
+            cache.getSize(font, 1.0f, "a", width, height);
+            check("text_measure_cache: recently used kept", cache.getStats().hits == 1);
+            cache.getSize(font, 1.0f, "b", width, height);
+            check("text_measure_cache: least recently used evicted", cache.getStats().misses == 1);
+            float expectedWidth, expectedHeight;
+            font->getSize("b", 1.0f, expectedWidth, expectedHeight);
+            check("text_measure_cache: measured size", (width == expectedWidth) && (height == expectedHeight));
+            cache.setCapacity(1);
+            check("text_measure_cache: reduced capacity", cache.size() == 1);
+            cache.invalidate(*font);
+            check("text_measure_cache: invalidate", cache.size() == 0);
+        }
+
+        // Mutations posted by concurrent threads are all run, in the posting order of each thread
+        void mutationQueue() {
+            MutationQueue queue;
+            auto nested = 0;
+            queue.post([&] {
+                queue.post([&] { nested += 1; });
+            });
+            check("mutation_queue: drain count", queue.drain() == 1);
+            check("mutation_queue: posted while draining run by the next drain", (nested == 0) && (queue.drain() == 1) && (nested == 1));
+            check("mutation_queue: empty", queue.empty() && (queue.drain() == 0));
+
+            constexpr auto THREADS = 4;
+            constexpr auto MUTATIONS = 10000;
+            std::array<std::vector<int>, THREADS> runs;
+            {
+                std::vector<std::jthread> producers;
+                for (auto thread = 0; thread < THREADS; thread++) {
+                    producers.emplace_back([&queue, &runs, thread] {
+                        for (auto i = 0; i < MUTATIONS; i++) {
+                            // Run on this thread by drain() : no synchronization of `runs`
+                            queue.post([&runs, thread, i] { runs[thread].push_back(i); });
+                        }
+                    });
+                }
+                auto total = size_t{0};
+                while (total < THREADS * MUTATIONS) {
+                    total += queue.drain();
+                }
+            }
+            auto ordered = true;
+            for (const auto& run : runs) {
+                ordered &= (run.size() == MUTATIONS) && std::ranges::is_sorted(run);
+            }
+            check("mutation_queue: all run in the posting order", ordered);
+        }
+
+        // Published snapshots hold the values of a frame and are not reused while read
+        void widgetSnapshots() {
+            const auto window = windowManager.create(Rect{0.0f, 0.0f, 1000.0f, 1000.0f});
+            const auto scrollBar = window->create<VScrollBar>(Alignment::RIGHT);
+            const auto textEdit = window->create<TextEdit>(Alignment::TOP, "abc");
+            {
+                WidgetSnapshots snapshots;
+                scrollBar->setValue(10.0f);
+                snapshots.watch(scrollBar);
+                snapshots.watch(textEdit);
+                snapshots.publish();
+                const auto first = snapshots.get();
+                check("widget_snapshots: value", first->getValue(scrollBar->id) == 10.0f);
+                check("widget_snapshots: text", first->getText(textEdit->id) == "abc");
+                check("widget_snapshots: not watched", !first->getValue(textEdit->id).has_value());
+
+                const auto frame = first->getFrame();
+                snapshots.publish();
+                check("widget_snapshots: unchanged values not published", snapshots.get()->getFrame() == frame);
+
+                scrollBar->setValue(20.0f);
+                textEdit->setText("abcd");
+                snapshots.publish();
+                {
+                    const auto second = snapshots.get();
+                    check("widget_snapshots: new values", (second->getValue(scrollBar->id) == 20.0f) && (second->getText(textEdit->id) == "abcd"));
+                    check("widget_snapshots: read snapshot kept", (first->getValue(scrollBar->id) == 10.0f) && (first->getText(textEdit->id) == "abc"));
+                }
+                // Published by this thread while another one reads
+                scrollBar->setValue(0.0f);
+                textEdit->setText("0");
+                snapshots.publish();
+                std::atomic stop{false};
+                auto consistent = true;
+                std::jthread reader{[&] {
+                    while (!stop.load()) {
+                        const auto snapshot = snapshots.get();
+                        const auto value = snapshot->getValue(scrollBar->id);
+                        const auto text = snapshot->getText(textEdit->id);
+                        // Both values are captured together
+                        consistent &= value.has_value() && text.has_value() &&
+                                      (std::format("{}", static_cast<int>(*value)) == *text);
+                    }
+                }};
+                for (auto i = 0; i < 1000; i++) {
+                    scrollBar->setValue(static_cast<float>(i % 100));
+                    textEdit->setText(std::format("{}", i % 100));
+                    snapshots.publish();
+                }
+                stop.store(true);
+                reader.join();
+                check("widget_snapshots: consistent reads", consistent);
+
+                snapshots.unwatch(*textEdit);
+                snapshots.publish();
+                check("widget_snapshots: unwatch", !snapshots.get()->getText(textEdit->id).has_value());
+            }
+            window->close();
+            windowManager.drawFrame();
+        }
+
+        int getFailures() const { return failures; }
+
+    private:
+        WindowManager& windowManager;
+        int failures{0};
+
+        void check(const std::string& name, const bool success) {
+            if (!success) {
+                std::cerr << "FAILED " << name << std::endl;
+                failures += 1;
+            }
+        }
+
+        template <typename T>
+        void checkPrefixSums(const std::string& name, const BasicPrefixSums<T>& sums, const std::vector<T>& expected) {
+            auto prefix = T{};
+            auto matches = sums.size() == static_cast<int32>(expected.size());
+            for (auto i = 0; matches && (i < sums.size()); i++) {
+                matches &= (sums.prefix(i) == prefix) && (sums.get(i) == expected[i]);
+                // The first & last position of the row
+                matches &= (sums.find(prefix) == i) && (sums.find(prefix + expected[i] - 1) == i);
+                prefix += expected[i];
+            }
+            check(name + " prefix", matches);
+            check(name + " total", sums.total() == prefix);
+            check(name + " after the last row", sums.find(prefix) == sums.size());
+        }
+
+        // Returns true if a visible session of the renderer draws the text
+        bool isTextDrawn(const std::string& text) const {
+            for (const auto& session : windowManager.getRenderer().getSessions() | std::views::values) {
+                if (!session.visible) { continue; }
+                for (const auto& command : session.commands) {
+                    if ((command.type == RecordingRenderer::Command::TEXT) && (command.text == text)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    };
+
+}
+
+int main(const int argc, char** argv) {
+    using namespace lysa::ui::tests;
+    std::string font{"app://res/fonts/Signwood"};
+    for (auto i = 1; (i + 1) < argc; i += 2) {
+        if (std::string{argv[i]} == "--font") {
+            font = argv[i + 1];
+        }
+    }
+
+    lysa::ContextConfiguration contextConfiguration{};
+    lysa::Lysa lysa(contextConfiguration);
+    lysa::ui::WindowManager windowManager(font);
+
+    Tests tests{windowManager};
+    tests.virtualListBoxFirstFrame();
+    tests.prefixSums();
+    tests.gapBuffer();
+    tests.rope();
+    tests.textMeasureCacheEviction();
+    tests.mutationQueue();
+    tests.widgetSnapshots();
+    return tests.getFailures() == 0 ? 0 : 1;
+}